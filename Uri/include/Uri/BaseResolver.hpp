@@ -0,0 +1,206 @@
+#ifndef URI_BASE_RESOLVER_HPP
+#define URI_BASE_RESOLVER_HPP
+
+/**
+ * @file BaseResolver.hpp
+ *
+ * This module declares the Uri::BaseResolver class, which resolves
+ * many URI references against the same base URI, and the
+ * Uri::ResolvedBatch structure into which it puts the target URIs.
+ */
+
+#include <Uri/StringView.hpp>
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Uri
+{
+/**
+ * This holds the target URIs found by resolving a batch of URI
+ * references, one after another in a single string, rather than
+ * as one string per URI.
+ *
+ * The target of reference i is found at arena + offsets[i], and is
+ * offsets[i + 1] - offsets[i] characters long.  The target of
+ * a reference which is not valid is empty.
+ */
+struct ResolvedBatch {
+  // Properties
+
+  /**
+   * This is the number of references in the batch.
+   */
+  size_t count = 0;
+
+  /**
+   * This holds the characters of all the target URIs.
+   */
+  std::string arena;
+
+  /**
+   * These are the offsets in the arena where each target URI begins,
+   * plus one more entry, which is where the last one ends.
+   */
+  std::vector< size_t > offsets;
+
+  /**
+   * This is a bitmap with one bit for each reference, which is set
+   * if the reference is valid.
+   */
+  std::vector< uint64_t > valid;
+
+  // Methods
+
+  /**
+   * This method returns an indication of whether or not
+   * the given reference of the batch is valid.
+   */
+  bool IsValid(size_t index) const {
+    return ((valid[index / 64] >> (index % 64)) & 1) != 0;
+  }
+
+  /**
+   * This method returns the target URI of the given reference
+   * of the batch, which is valid until the batch is changed
+   * or destroyed.
+   */
+  StringView Get(size_t index) const {
+    return StringView(arena.data() + offsets[index], offsets[index + 1] - offsets[index]);
+  }
+};
+
+/**
+ * This class resolves URI references against one base URI, as
+ * described in RFC 3986 section 5.2, such as all the links found
+ * in one web page.
+ *
+ * The base is parsed and taken apart once, up front, and everything
+ * of it which a target URI may begin with, the scheme, the authority,
+ * and the directory of its path, is kept ready to be copied.  Resolving
+ * a relative path, the usual case, is then a matter of parsing the
+ * reference and copying two runs of characters, unless either has
+ * dot segments to remove.
+ */
+class BaseResolver
+{
+  // Lifecycle management
+public:
+  ~BaseResolver();
+  BaseResolver(const BaseResolver &other);
+  BaseResolver(BaseResolver &&other) noexcept;
+  BaseResolver &operator=(const BaseResolver &other);
+  BaseResolver &operator=(BaseResolver &&other) noexcept;
+
+  // Public methods
+public:
+  /**
+   * This is the default constructor, which makes a resolver
+   * with an empty base URI.
+   */
+  BaseResolver();
+
+  /**
+   * This method sets the base URI against which references
+   * are resolved.
+   *
+   * @param[in] baseString
+   *     This is the string rendering of the base URI, which should
+   *     have a scheme.
+   *
+   * @return
+   *     An indication of whether or not the base URI is valid is
+   *     returned.  If it isn't, the base URI is left empty.
+   */
+  bool SetBase(const std::string &baseString);
+
+  /**
+   * This method returns the base URI against which
+   * references are resolved.
+   */
+  StringView GetBase() const;
+
+  /**
+   * This method resolves one URI reference.
+   *
+   * @param[in] data
+   *     This points to the characters of the reference.
+   *
+   * @param[in] length
+   *     This is the number of characters of the reference.
+   *
+   * @param[out] target
+   *     This is where to put the target URI.  If the reference
+   *     isn't valid, it's left unchanged.
+   *
+   * @return
+   *     An indication of whether or not the reference
+   *     is valid is returned.
+   */
+  bool Resolve(const char *data, size_t length, std::string &target) const;
+
+  /**
+   * This method resolves a batch of URI references, laid out one
+   * after another in one buffer, putting all the target URIs in the
+   * arena of the given results, which is allocated only once.
+   *
+   * @param[in] buffer
+   *     This holds the characters of the references.
+   *
+   * @param[in] offsets
+   *     These are the offsets in the buffer where each reference
+   *     begins, plus one more entry, which is where the last
+   *     one ends.
+   *
+   * @param[in] count
+   *     This is the number of references in the batch.
+   *
+   * @param[out] results
+   *     This is where to put the target URIs.
+   *
+   * @return
+   *     The number of valid references is returned.
+   */
+  size_t ResolveBatch(
+    const char *buffer,
+    const size_t *offsets,
+    size_t count,
+    ResolvedBatch &results
+  ) const;
+
+  // Private properties
+private:
+  /**
+   * This is the type of structure that contains the private
+   * properties of the instance.  It is defined in the implementation
+   * and declared here to ensure that it is scoped inside the class.
+   */
+  struct Impl;
+
+  /**
+   * This contains the private properties of the instance.
+   */
+  std::unique_ptr< struct Impl > impl_;
+
+  // Private methods
+private:
+  /**
+   * This method returns the private properties of the instance,
+   * which are those of a resolver with an empty base URI if the
+   * instance was moved from.
+   */
+  const Impl &impl() const;
+
+  /**
+   * This method returns the private properties of the instance,
+   * for changing them, first giving it those of a resolver with an
+   * empty base URI if the instance was moved from.
+   */
+  Impl &impl();
+};
+} // namespace Uri
+
+#endif /* URI_BASE_RESOLVER_HPP */
@@ -0,0 +1,187 @@
+#ifndef URI_CHARACTER_CLASSES_HPP
+#define URI_CHARACTER_CLASSES_HPP
+
+/**
+ * @file CharacterClasses.hpp
+ *
+ * This module declares the character classes of the URI grammar of
+ * RFC 3986 (https://tools.ietf.org/html/rfc3986), and a table,
+ * built at compile time, of the classes to which each character
+ * belongs.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+namespace CharacterClasses
+{
+/**
+ * These are the character classes, as bits which are combined
+ * to make a set of classes.
+ */
+constexpr uint16_t ALPHA = 0x0001;
+constexpr uint16_t DIGIT = 0x0002;
+constexpr uint16_t HEXDIG = 0x0004;
+constexpr uint16_t UNRESERVED = 0x0008;
+constexpr uint16_t SUB_DELIMS = 0x0010;
+constexpr uint16_t GEN_DELIMS = 0x0020;
+
+/**
+ * These are the characters allowed in a scheme:
+ * ALPHA / DIGIT / "+" / "-" / "."
+ */
+constexpr uint16_t SCHEME = 0x0040;
+
+/**
+ * These are the characters allowed, other than in percent-encoded
+ * octets, in user info: unreserved / sub-delims / ":"
+ */
+constexpr uint16_t USER_INFO = 0x0080;
+
+/**
+ * These are the characters allowed, other than in percent-encoded
+ * octets, in a reg-name host: unreserved / sub-delims
+ */
+constexpr uint16_t REG_NAME = 0x0100;
+
+/**
+ * These are the characters allowed, other than in percent-encoded
+ * octets, in a path segment: unreserved / sub-delims / ":" / "@"
+ */
+constexpr uint16_t PCHAR = 0x0200;
+
+/**
+ * These are the characters allowed, other than in percent-encoded
+ * octets, in a query or fragment: pchar / "/" / "?"
+ */
+constexpr uint16_t QUERY_OR_FRAGMENT = 0x0400;
+
+/**
+ * This function determines whether or not the given character
+ * is one of the characters of the given string.
+ */
+constexpr bool IsOneOf(unsigned int c, const char* characters) {
+    return (
+        (*characters != '\0')
+        && (
+            ((unsigned char)*characters == c)
+            || IsOneOf(c, characters + 1)
+        )
+    );
+}
+
+/**
+ * This function computes the set of classes to which the given
+ * character belongs, straight from the definitions of RFC 3986.
+ * Use GetClasses instead, which looks the set up in a table.
+ */
+constexpr uint16_t ComputeClasses(unsigned int c) {
+    return (uint16_t)(
+        (
+            (((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')))
+            ? (ALPHA | UNRESERVED | SCHEME | USER_INFO | REG_NAME | PCHAR | QUERY_OR_FRAGMENT)
+            : 0
+        )
+        | (
+            ((c >= '0') && (c <= '9'))
+            ? (DIGIT | HEXDIG | UNRESERVED | SCHEME | USER_INFO | REG_NAME | PCHAR | QUERY_OR_FRAGMENT)
+            : 0
+        )
+        | (IsOneOf(c, "ABCDEFabcdef") ? HEXDIG : 0)
+        | (
+            IsOneOf(c, "-._~")
+            ? (UNRESERVED | USER_INFO | REG_NAME | PCHAR | QUERY_OR_FRAGMENT)
+            : 0
+        )
+        | (
+            IsOneOf(c, "!$&'()*+,;=")
+            ? (SUB_DELIMS | USER_INFO | REG_NAME | PCHAR | QUERY_OR_FRAGMENT)
+            : 0
+        )
+        | (IsOneOf(c, ":/?#[]@") ? GEN_DELIMS : 0)
+        | (IsOneOf(c, "+-.") ? SCHEME : 0)
+        | ((c == ':') ? USER_INFO : 0)
+        | (IsOneOf(c, ":@") ? (PCHAR | QUERY_OR_FRAGMENT) : 0)
+        | (IsOneOf(c, "/?") ? QUERY_OR_FRAGMENT : 0)
+    );
+}
+
+/**
+ * This is a compile-time sequence of the integers given
+ * as template arguments.
+ */
+template< size_t... I > struct IndexSequence {};
+
+/**
+ * This makes the sequence of the integers from 0 through N - 1.
+ */
+template< size_t N, size_t... I > struct MakeIndexSequence
+    : MakeIndexSequence< N - 1, N - 1, I... >
+{
+};
+template< size_t... I > struct MakeIndexSequence< 0, I... >
+    : IndexSequence< I... >
+{
+};
+
+/**
+ * This is a table with an entry for every character.
+ */
+template< typename T > struct CharacterTable {
+    T entries[256];
+
+    /**
+     * This returns the entry for the given character.
+     */
+    constexpr T operator[](char c) const {
+        return entries[(unsigned char)c];
+    }
+};
+
+/**
+ * This function builds, at compile time, a table with an entry
+ * for every character, computed by the given function.
+ */
+template< typename T, size_t... I >
+constexpr CharacterTable< T > MakeCharacterTable(
+    T (*compute)(unsigned int),
+    IndexSequence< I... >
+) {
+    return CharacterTable< T >{{compute(I)...}};
+}
+
+/**
+ * This holds the table of the classes to which each character
+ * belongs.  It is a member of a class template only so that
+ * the one table is shared by every module which uses it.
+ */
+template< typename Unused = void > struct Tables {
+    static constexpr CharacterTable< uint16_t > classes = MakeCharacterTable(
+        ComputeClasses,
+        MakeIndexSequence< 256 >()
+    );
+};
+template< typename Unused >
+constexpr CharacterTable< uint16_t > Tables< Unused >::classes;
+
+/**
+ * This function returns the set of classes to which the
+ * given character belongs.
+ */
+constexpr uint16_t GetClasses(char c) {
+    return Tables<>::classes[c];
+}
+
+/**
+ * This function determines whether or not the given character
+ * belongs to any of the given classes.
+ */
+constexpr bool Is(char c, uint16_t classes) {
+    return ((GetClasses(c) & classes) != 0);
+}
+} // namespace CharacterClasses
+} // namespace Uri
+
+#endif /* URI_CHARACTER_CLASSES_HPP */
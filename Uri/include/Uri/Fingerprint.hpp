@@ -0,0 +1,165 @@
+#ifndef URI_FINGERPRINT_HPP
+#define URI_FINGERPRINT_HPP
+
+/**
+ * @file Fingerprint.hpp
+ *
+ * This module declares the functions which compute a fingerprint of
+ * selected elements of a URI, such as a cache key, straight from its
+ * characters, without building a Uri::Uri first.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Uri
+{
+class Uri;
+
+/**
+ * These are the elements of a URI which may be put into a
+ * fingerprint, as bits which are combined to make a set of elements.
+ */
+constexpr unsigned int FINGERPRINT_SCHEME = 0x01;
+constexpr unsigned int FINGERPRINT_USER_INFO = 0x02;
+constexpr unsigned int FINGERPRINT_HOST = 0x04;
+constexpr unsigned int FINGERPRINT_PORT = 0x08;
+constexpr unsigned int FINGERPRINT_PATH = 0x10;
+constexpr unsigned int FINGERPRINT_QUERY = 0x20;
+constexpr unsigned int FINGERPRINT_FRAGMENT = 0x40;
+constexpr unsigned int FINGERPRINT_ALL = 0x7F;
+
+/**
+ * These are the choices of what goes into a fingerprint.
+ */
+struct FingerprintOptions {
+    /**
+     * This is the set of FINGERPRINT_ elements of the URI
+     * which go into the fingerprint.
+     */
+    unsigned int elements = FINGERPRINT_HOST | FINGERPRINT_PATH | FINGERPRINT_QUERY;
+
+    /**
+     * This indicates whether or not the parameters of the query,
+     * separated by "&", may come in any order, so that, for example,
+     * "a=1&b=2" and "b=2&a=1" have the same fingerprint.
+     */
+    bool unorderedQuery = true;
+
+    /**
+     * This indicates whether or not well-known parameters which track
+     * where a visitor came from, such as "utm_source" or "gclid", and
+     * so never change the resource, are left out of the fingerprint.
+     */
+    bool excludeTrackingParameters = false;
+
+    /**
+     * These are the keys of any other query parameters
+     * to leave out of the fingerprint.
+     */
+    std::vector< std::string > excludedParameters;
+
+    /**
+     * This is mixed into the fingerprint, so that fingerprints
+     * made with different seeds are unrelated.
+     */
+    uint64_t seed = 0;
+};
+
+/**
+ * This is a 128-bit fingerprint.
+ */
+struct Fingerprint128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    /**
+     * These compare fingerprints.
+     */
+    bool operator==(const Fingerprint128& other) const {
+        return (low == other.low) && (high == other.high);
+    }
+    bool operator!=(const Fingerprint128& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * This function computes a fingerprint of selected elements of the URI
+ * made up by the given characters, in the same call that parses them,
+ * without copying any of them anywhere but for the few which need
+ * normalizing.
+ *
+ * The elements are normalized as they are by Uri::Uri::Normalize,
+ * so URIs which differ only in how they're written, such as in the
+ * case of the host, or whether a port is the default one, have the
+ * same fingerprint.
+ *
+ * @param[in] data
+ *     This points to the characters of the URI.
+ *
+ * @param[in] length
+ *     This is the number of characters of the URI.
+ *
+ * @param[in] options
+ *     These are the choices of what goes into the fingerprint.
+ *
+ * @param[out] fingerprint
+ *     This is where to put the fingerprint.
+ *
+ * @return
+ *     An indication of whether or not the characters make up a valid
+ *     URI is returned.  If they don't, the fingerprint is unchanged.
+ */
+bool Fingerprint(
+    const char* data,
+    size_t length,
+    const FingerprintOptions& options,
+    Fingerprint128& fingerprint
+);
+
+/**
+ * This function is the same as the one above, except that it
+ * computes a 64-bit fingerprint.
+ */
+bool Fingerprint(
+    const char* data,
+    size_t length,
+    const FingerprintOptions& options,
+    uint64_t& fingerprint
+);
+
+/**
+ * This function computes a fingerprint of selected elements of
+ * a URI which has already been parsed.  It's the same as the
+ * fingerprint computed from the characters of the URI.
+ *
+ * @param[in] uri
+ *     This is the URI.
+ *
+ * @param[in] options
+ *     These are the choices of what goes into the fingerprint.
+ *
+ * @param[out] fingerprint
+ *     This is where to put the fingerprint.
+ */
+void Fingerprint(
+    const Uri& uri,
+    const FingerprintOptions& options,
+    Fingerprint128& fingerprint
+);
+
+/**
+ * This function is the same as the one above, except that it
+ * computes a 64-bit fingerprint.
+ */
+void Fingerprint(
+    const Uri& uri,
+    const FingerprintOptions& options,
+    uint64_t& fingerprint
+);
+} // namespace Uri
+
+#endif /* URI_FINGERPRINT_HPP */
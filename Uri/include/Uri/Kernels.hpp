@@ -0,0 +1,79 @@
+#ifndef URI_KERNELS_HPP
+#define URI_KERNELS_HPP
+
+/**
+ * @file Kernels.hpp
+ *
+ * This module declares the functions which select the implementations
+ * ("kernels") of the inner loops of the Uri library, such as scanning
+ * for delimiters, which are specialized for various instruction sets.
+ *
+ * The best kernels the processor supports are picked the first time
+ * any are needed.  The choice can be overridden by setting the
+ * URI_KERNELS environment variable to the name of a kernel set
+ * ("scalar", "sse2", "avx2", or "avx512"); setting it to "scalar"
+ * forces the portable implementations to be used.
+ */
+
+namespace Uri
+{
+/**
+ * These are the sets of kernels, each specialized for
+ * an instruction set.
+ */
+enum class KernelSet {
+    /**
+     * These are the portable kernels, which work one character
+     * at a time.
+     */
+    Scalar,
+
+    /**
+     * These kernels use SSE2, working on 16 characters at a time.
+     */
+    Sse2,
+
+    /**
+     * These kernels use AVX2, working on 32 characters at a time.
+     */
+    Avx2,
+
+    /**
+     * These kernels use AVX-512 (F and BW), working on 64 characters
+     * at a time.
+     */
+    Avx512,
+};
+
+/**
+ * This function returns the set of kernels currently in use.
+ */
+KernelSet GetKernelSet();
+
+/**
+ * This function returns the name of the given set of kernels,
+ * as accepted in the URI_KERNELS environment variable.
+ */
+const char* GetKernelSetName(KernelSet kernelSet);
+
+/**
+ * This function returns an indication of whether or not the
+ * processor supports the given set of kernels.
+ */
+bool IsKernelSetSupported(KernelSet kernelSet);
+
+/**
+ * This function changes the set of kernels in use, which is
+ * useful for comparing kernels with each other.
+ *
+ * @param[in] kernelSet
+ *     This is the set of kernels to use.
+ *
+ * @return
+ *     An indication of whether or not the set of kernels is
+ *     supported by the processor, and so was selected, is returned.
+ */
+bool SelectKernelSet(KernelSet kernelSet);
+} // namespace Uri
+
+#endif /* URI_KERNELS_HPP */
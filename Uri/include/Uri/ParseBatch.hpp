@@ -0,0 +1,210 @@
+#ifndef URI_PARSE_BATCH_HPP
+#define URI_PARSE_BATCH_HPP
+
+/**
+ * @file ParseBatch.hpp
+ *
+ * This module declares the Uri::ParseBatch function, which parses
+ * many URIs at once, and the Uri::BatchResults structure into which
+ * it puts what it finds.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Uri
+{
+/**
+ * This holds where the elements of each URI of a batch were found,
+ * as a set of parallel arrays with one entry per URI, rather than
+ * as one object per URI.
+ *
+ * The offsets are counted from the first character of each URI, so
+ * that, for example, the host of URI i is found at
+ * buffer + offsets[i] + hostBegin[i], and is
+ * hostEnd[i] - hostBegin[i] characters long.  The scheme always
+ * begins at offset 0.
+ *
+ * The entries of a URI which is not valid are all zero.
+ */
+struct BatchResults {
+    // Types
+
+    /**
+     * These are the bits of the flags entries, which indicate
+     * which elements each URI has.
+     */
+    enum Flag : uint8_t {
+        HasScheme = 0x01,
+        HasAuthority = 0x02,
+        HasPort = 0x04,
+        HasQuery = 0x08,
+        HasFragment = 0x10,
+    };
+
+    // Properties
+
+    /**
+     * This is the number of URIs in the batch.
+     */
+    size_t count = 0;
+
+    /**
+     * These are the offsets of the ends of the schemes.
+     */
+    std::vector< uint32_t > schemeEnd;
+
+    /**
+     * These are the offsets of the beginnings and ends of the hosts.
+     */
+    std::vector< uint32_t > hostBegin;
+    std::vector< uint32_t > hostEnd;
+
+    /**
+     * These are the port numbers.
+     */
+    std::vector< uint16_t > port;
+
+    /**
+     * These are the offsets of the beginnings and ends of the paths.
+     */
+    std::vector< uint32_t > pathBegin;
+    std::vector< uint32_t > pathEnd;
+
+    /**
+     * These are the offsets of the beginnings and ends of the queries.
+     */
+    std::vector< uint32_t > queryBegin;
+    std::vector< uint32_t > queryEnd;
+
+    /**
+     * These are the offsets of the beginnings and ends
+     * of the fragments.
+     */
+    std::vector< uint32_t > fragmentBegin;
+    std::vector< uint32_t > fragmentEnd;
+
+    /**
+     * These indicate which elements each URI has.
+     */
+    std::vector< uint8_t > flags;
+
+    /**
+     * This is a bitmap indicating which URIs are valid.  URI i is
+     * valid if bit (i % 64) of entry (i / 64) is set.
+     */
+    std::vector< uint64_t > valid;
+
+    // Methods
+
+    /**
+     * This method makes room for the results of the given number
+     * of URIs, reusing the memory already held where it can.
+     */
+    void Resize(size_t newCount);
+
+    /**
+     * This method returns an indication of whether or not
+     * the given URI of the batch is valid.
+     */
+    bool IsValid(size_t index) const {
+        return ((valid[index / 64] >> (index % 64)) & 1) != 0;
+    }
+
+    /**
+     * This method returns an indication of whether or not
+     * the given URI of the batch has the given element.
+     */
+    bool Has(size_t index, Flag flag) const {
+        return ((flags[index] & flag) != 0);
+    }
+};
+
+/**
+ * These are the options for parsing a batch of URIs
+ * on more than one thread.
+ */
+struct BatchOptions {
+    /**
+     * This is the number of threads to use, or zero to use
+     * one for each hardware thread.
+     */
+    size_t threads = 0;
+
+    /**
+     * This is the number of URIs handed to a thread at a time, which
+     * is rounded up to a multiple of 64 so that no two threads write
+     * the same word of the validity bitmap.  Smaller chunks spread
+     * the work more evenly; larger ones cost less to hand out.
+     */
+    size_t grainSize = 4096;
+};
+
+/**
+ * This function parses a batch of URIs held one after another in a
+ * buffer, without making an object for any of them, and records where
+ * their elements are in the given results.
+ *
+ * @param[in] buffer
+ *     This points to the characters of the URIs.
+ *
+ * @param[in] offsets
+ *     This points to count + 1 offsets into the buffer, where URI i
+ *     is made of the characters from offsets[i] up to, but not
+ *     including, offsets[i + 1].
+ *
+ * @param[in] count
+ *     This is the number of URIs in the batch.
+ *
+ * @param[out] results
+ *     This is where to record what was found, which is resized to
+ *     hold the results of the batch.
+ *
+ * @return
+ *     The number of URIs in the batch which are valid is returned.
+ */
+size_t ParseBatch(
+    const char* buffer,
+    const size_t* offsets,
+    size_t count,
+    BatchResults& results
+);
+
+/**
+ * This function parses a batch of URIs, like the other overload, but
+ * splits the batch into chunks, which are spread across threads that
+ * steal chunks from each other as they run out.  The results are the
+ * same as if the URIs were parsed one after another.
+ *
+ * @param[in] buffer
+ *     This points to the characters of the URIs.
+ *
+ * @param[in] offsets
+ *     This points to count + 1 offsets into the buffer, where URI i
+ *     is made of the characters from offsets[i] up to, but not
+ *     including, offsets[i + 1].
+ *
+ * @param[in] count
+ *     This is the number of URIs in the batch.
+ *
+ * @param[out] results
+ *     This is where to record what was found, which is resized to
+ *     hold the results of the batch.
+ *
+ * @param[in] options
+ *     These control how the batch is split across threads.
+ *
+ * @return
+ *     The number of URIs in the batch which are valid is returned.
+ */
+size_t ParseBatch(
+    const char* buffer,
+    const size_t* offsets,
+    size_t count,
+    BatchResults& results,
+    const BatchOptions& options
+);
+} // namespace Uri
+
+#endif /* URI_PARSE_BATCH_HPP */
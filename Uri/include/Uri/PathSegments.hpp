@@ -0,0 +1,260 @@
+#ifndef URI_PATH_SEGMENTS_HPP
+#define URI_PATH_SEGMENTS_HPP
+
+/**
+ * @file PathSegments.hpp
+ *
+ * This module declares the Uri::PathSegments class.
+ */
+
+#include <Uri/StringView.hpp>
+
+#include <iterator>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string.h>
+#include <vector>
+
+namespace Uri
+{
+/**
+ * This class is a non-owning view of the segments of the path of a
+ * URI, which reads them straight out of where the URI keeps them,
+ * without building a container.
+ *
+ * The segments are located through a table of boundaries: entry N is
+ * the offset of the first character of segment N, and each segment
+ * ends one character (the slash) before the next one begins.  There
+ * is one more entry than there are segments, so the last segment
+ * ends the same way.
+ *
+ * @note
+ *     The view, and the segments it hands out, are only valid until
+ *     the URI from which they were obtained is changed or destroyed.
+ */
+class PathSegments
+{
+  // Types
+public:
+  /**
+   * This is the type of iterator over the segments.
+   */
+  class Iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = StringView;
+    using difference_type = ptrdiff_t;
+    using pointer = const StringView *;
+    using reference = StringView;
+
+    Iterator() = default;
+
+    StringView operator*() const { return Segment(characters_, boundaries_, wideBoundaries_, index_); }
+    StringView operator[](difference_type n) const { return Segment(characters_, boundaries_, wideBoundaries_, index_ + n); }
+    Iterator &operator++() { ++index_; return *this; }
+    Iterator operator++(int) { Iterator old(*this); ++index_; return old; }
+    Iterator &operator--() { --index_; return *this; }
+    Iterator operator--(int) { Iterator old(*this); --index_; return old; }
+    Iterator &operator+=(difference_type n) { index_ += n; return *this; }
+    Iterator &operator-=(difference_type n) { index_ -= n; return *this; }
+    Iterator operator+(difference_type n) const { Iterator moved(*this); moved.index_ += n; return moved; }
+    Iterator operator-(difference_type n) const { Iterator moved(*this); moved.index_ -= n; return moved; }
+    difference_type operator-(const Iterator &other) const { return (difference_type)(index_ - other.index_); }
+    bool operator==(const Iterator &other) const { return index_ == other.index_; }
+    bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+    bool operator<(const Iterator &other) const { return index_ < other.index_; }
+    bool operator>(const Iterator &other) const { return index_ > other.index_; }
+    bool operator<=(const Iterator &other) const { return index_ <= other.index_; }
+    bool operator>=(const Iterator &other) const { return index_ >= other.index_; }
+
+  private:
+    friend class PathSegments;
+
+    /**
+     * This constructs an iterator at the given segment.  It keeps
+     * what it needs to locate the segments itself, rather than
+     * pointing to the view, so that it stays valid after the
+     * view, but not the URI, is gone.
+     */
+    Iterator(const PathSegments &segments, size_t index)
+        : characters_(segments.characters_)
+        , boundaries_(segments.boundaries_)
+        , wideBoundaries_(segments.wideBoundaries_)
+        , index_(index)
+    {
+    }
+
+    const char *characters_ = nullptr;
+    const char *boundaries_ = nullptr;
+    bool wideBoundaries_ = false;
+    size_t index_ = 0;
+  };
+
+  using value_type = StringView;
+  using size_type = size_t;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  // Public methods
+public:
+  /**
+   * This is the default constructor, which makes an empty path.
+   */
+  PathSegments() = default;
+
+  /**
+   * This constructs a view of the segments of a path.
+   *
+   * @param[in] characters
+   *     This points to the characters which the boundaries locate.
+   *
+   * @param[in] boundaries
+   *     This points to the table of segment boundaries, which
+   *     need not be aligned.
+   *
+   * @param[in] count
+   *     This is the number of segments.
+   *
+   * @param[in] wideBoundaries
+   *     This indicates whether the entries of the table of segment
+   *     boundaries are 32 bits wide, rather than 16.
+   */
+  PathSegments(
+      const char *characters,
+      const char *boundaries,
+      size_t count,
+      bool wideBoundaries
+  )
+      : characters_(characters)
+      , boundaries_(boundaries)
+      , count_(count)
+      , wideBoundaries_(wideBoundaries)
+  {
+  }
+
+  /**
+   * This returns the number of segments.
+   */
+  size_t size() const { return count_; }
+
+  /**
+   * This returns an indication of whether or not there are
+   * no segments.
+   */
+  bool empty() const { return count_ == 0; }
+
+  /**
+   * This returns the segment at the given index.
+   */
+  StringView operator[](size_t index) const
+  {
+    return Segment(characters_, boundaries_, wideBoundaries_, index);
+  }
+
+  /**
+   * This returns the first segment, of which there must be one.
+   */
+  StringView front() const { return (*this)[0]; }
+
+  /**
+   * This returns the last segment, of which there must be one.
+   */
+  StringView back() const { return (*this)[count_ - 1]; }
+
+  /**
+   * This returns an iterator to the first segment.
+   */
+  Iterator begin() const { return Iterator(*this, 0); }
+
+  /**
+   * This returns an iterator past the last segment.
+   */
+  Iterator end() const { return Iterator(*this, count_); }
+
+  /**
+   * This makes a copy of the segments.
+   */
+  operator std::vector< std::string >() const
+  {
+    std::vector< std::string > segments;
+    segments.reserve(count_);
+    for (const auto segment: *this) {
+      segments.push_back(segment);
+    }
+    return segments;
+  }
+
+  // Private methods
+private:
+  /**
+   * This returns the given entry of the given table
+   * of segment boundaries.
+   */
+  static size_t Boundary(const char *boundaries, bool wideBoundaries, size_t index)
+  {
+    if (wideBoundaries) {
+      uint32_t boundary;
+      memcpy(&boundary, boundaries + index * sizeof(boundary), sizeof(boundary));
+      return boundary;
+    } else {
+      uint16_t boundary;
+      memcpy(&boundary, boundaries + index * sizeof(boundary), sizeof(boundary));
+      return boundary;
+    }
+  }
+
+  /**
+   * This returns the segment at the given index, located
+   * by the given table of segment boundaries.
+   */
+  static StringView Segment(
+      const char *characters,
+      const char *boundaries,
+      bool wideBoundaries,
+      size_t index
+  )
+  {
+    const size_t begin = Boundary(boundaries, wideBoundaries, index);
+    return StringView(characters + begin, Boundary(boundaries, wideBoundaries, index + 1) - 1 - begin);
+  }
+
+  // Private properties
+private:
+  const char *characters_ = nullptr;
+  const char *boundaries_ = nullptr;
+  size_t count_ = 0;
+  bool wideBoundaries_ = false;
+};
+
+inline bool operator==(const PathSegments &lhs, const std::vector< std::string > &rhs)
+{
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < rhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool operator==(const std::vector< std::string > &lhs, const PathSegments &rhs)
+{
+  return rhs == lhs;
+}
+
+inline bool operator!=(const PathSegments &lhs, const std::vector< std::string > &rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(const std::vector< std::string > &lhs, const PathSegments &rhs)
+{
+  return !(rhs == lhs);
+}
+} // namespace Uri
+
+#endif /* URI_PATH_SEGMENTS_HPP */
@@ -0,0 +1,383 @@
+#ifndef URI_PERCENT_ENCODING_HPP
+#define URI_PERCENT_ENCODING_HPP
+
+/**
+ * @file PercentEncoding.hpp
+ *
+ * This module declares the functions which percent-encode the
+ * elements of a URI, and decode their percent-encoded octets
+ * (RFC 3986 section 2.1).
+ */
+
+#include <Uri/CharacterClasses.hpp>
+#include <Uri/StringView.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Uri
+{
+/**
+ * This option for percent-decoding, which may be combined with
+ * the others, rejects a percent-encoded octet which decodes to NUL,
+ * which would end the element early for anything taking it as
+ * a C string, such as a file name.
+ */
+constexpr unsigned int DECODE_REJECT_NUL = 0x01;
+
+/**
+ * This option for percent-decoding, which may be combined with the
+ * others, rejects a percent-encoded octet which decodes to "/", which
+ * would turn one path segment into two, such as when mapping the
+ * path to a file.
+ */
+constexpr unsigned int DECODE_REJECT_SLASH = 0x02;
+
+/**
+ * This option for percent-decoding, which may be combined with the
+ * others, decodes each "+" as a space, as for the keys and values of
+ * a query in the application/x-www-form-urlencoded format.  A "+"
+ * which is itself percent-encoded ("%2B") stays a "+".
+ */
+constexpr unsigned int DECODE_PLUS_AS_SPACE = 0x04;
+
+/**
+ * These are the reasons why percent-decoding might fail.
+ */
+enum class DecodeError : uint8_t {
+    /**
+     * The characters were decoded.
+     */
+    None,
+
+    /**
+     * A "%" was not followed by two hexadecimal digits.
+     */
+    BadPercentEncoding,
+
+    /**
+     * A percent-encoded octet decoded to NUL, and
+     * DECODE_REJECT_NUL was given.
+     */
+    DecodedNul,
+
+    /**
+     * A percent-encoded octet decoded to "/", and
+     * DECODE_REJECT_SLASH was given.
+     */
+    DecodedSlash,
+};
+
+/**
+ * This is the outcome of percent-decoding characters.
+ */
+struct DecodeResult {
+    /**
+     * This is the reason why decoding failed, or None if it didn't.
+     */
+    DecodeError error = DecodeError::None;
+
+    /**
+     * This is the number of characters the decoded characters take
+     * up.  It's zero if decoding failed.
+     */
+    size_t length = 0;
+
+    /**
+     * This is where the "%" was found which began the percent-encoded
+     * octet which made decoding fail.  It's zero if decoding didn't.
+     */
+    size_t errorOffset = 0;
+
+    /**
+     * This returns an indication of whether or not decoding succeeded.
+     */
+    bool IsValid() const {
+        return (error == DecodeError::None);
+    }
+};
+
+/**
+ * This function decodes the given characters into the given buffer.
+ *
+ * Runs of characters with no "%" are found many characters at a time,
+ * and copied in bulk.
+ *
+ * @param[in] data
+ *     This points to the characters to decode.
+ *
+ * @param[in] length
+ *     This is the number of characters to decode.
+ *
+ * @param[out] output
+ *     This points to where to put the decoded characters, which must
+ *     have room for at least the given number of characters, since
+ *     decoding never makes characters longer.  It may be the same as
+ *     data, to decode the characters in place, but must not otherwise
+ *     overlap them.  If decoding fails, what it holds is unspecified.
+ *
+ * @param[in] options
+ *     These are the DECODE_ options to apply.
+ *
+ * @return
+ *     The number of characters decoded, or why they couldn't be
+ *     decoded and where, is returned.
+ */
+DecodeResult PercentDecode(
+    const char* data,
+    size_t length,
+    char* output,
+    unsigned int options = 0
+);
+
+/**
+ * This function decodes the characters of the given string in place,
+ * shrinking it to the length of the decoded characters.  If decoding
+ * fails, the string keeps its length, but what it holds is unspecified.
+ *
+ * @param[in,out] buffer
+ *     This holds the characters to decode, and receives the
+ *     decoded characters.
+ *
+ * @param[in] options
+ *     These are the DECODE_ options to apply.
+ *
+ * @return
+ *     The number of characters decoded, or why they couldn't be
+ *     decoded and where, is returned.
+ */
+DecodeResult PercentDecodeInPlace(
+    std::string& buffer,
+    unsigned int options = 0
+);
+
+/**
+ * This function decodes the given characters only if they need it.
+ * If they have no "%" in them (nor "+", if DECODE_PLUS_AS_SPACE is
+ * given), which is the usual case, the decoded
+ * view is of the given characters themselves, and nothing is copied;
+ * otherwise they're decoded into the given scratch string, and the
+ * decoded view is of that.
+ *
+ * @param[in] encoded
+ *     This is a view of the characters to decode.
+ *
+ * @param[in,out] scratch
+ *     This is where to put the decoded characters, if they
+ *     need to be put anywhere.
+ *
+ * @param[out] decoded
+ *     This is where to put the view of the decoded characters.
+ *     If decoding fails, it's left unchanged.
+ *
+ * @param[in] options
+ *     These are the DECODE_ options to apply.
+ *
+ * @return
+ *     The number of characters decoded, or why they couldn't be
+ *     decoded and where, is returned.
+ */
+DecodeResult PercentDecodeView(
+    StringView encoded,
+    std::string& scratch,
+    StringView& decoded,
+    unsigned int options = 0
+);
+
+/**
+ * This is a set of the characters which are allowed to appear as they
+ * are in an element of a URI, and so are not percent-encoded.  Every
+ * other character, including every character of 0x80 and above, is
+ * percent-encoded.
+ *
+ * The set is kept as a table indexed by the low nibble of a character,
+ * where bit N of an entry is set if the character with that low nibble
+ * and a high nibble of N is in the set, so that many characters can be
+ * looked up at once.  Use MakeEncodeSet to build one.
+ */
+struct EncodeSet {
+    uint8_t lowNibbleBits[16];
+
+    /**
+     * This returns an indication of whether or not the given character
+     * is allowed to appear as it is.
+     */
+    constexpr bool Allows(char c) const {
+        return (
+            ((unsigned char)c < 0x80)
+            && (((lowNibbleBits[c & 0x0F] >> ((unsigned char)c >> 4)) & 1) != 0)
+        );
+    }
+};
+
+/**
+ * This function computes, at compile time, the entry of the table of
+ * an EncodeSet for the given low nibble, from the given high nibble up.
+ */
+constexpr uint8_t EncodeSetNibbleBits(
+    bool (*allows)(unsigned int),
+    unsigned int low,
+    unsigned int high = 0
+) {
+    return (uint8_t)(
+        (high == 8) ? 0 : (
+            (allows((high << 4) | low) ? (1 << high) : 0)
+            | EncodeSetNibbleBits(allows, low, high + 1)
+        )
+    );
+}
+
+/**
+ * This function builds, at compile time, the set of the characters
+ * for which the given function returns true.
+ */
+template< size_t... I >
+constexpr EncodeSet MakeEncodeSet(
+    bool (*allows)(unsigned int),
+    CharacterClasses::IndexSequence< I... >
+) {
+    return EncodeSet{{EncodeSetNibbleBits(allows, (unsigned int)I)...}};
+}
+
+/**
+ * This function builds, at compile time, the set of the characters
+ * for which the given function returns true.
+ */
+constexpr EncodeSet MakeEncodeSet(bool (*allows)(unsigned int)) {
+    return MakeEncodeSet(allows, CharacterClasses::MakeIndexSequence< 16 >());
+}
+
+/**
+ * These functions determine whether or not the given character may
+ * appear as it is in each element of a URI.  Use the ENCODE_ sets
+ * built from them instead.
+ */
+constexpr bool AllowsInUserInfo(unsigned int c) {
+    return (CharacterClasses::ComputeClasses(c) & CharacterClasses::USER_INFO) != 0;
+}
+constexpr bool AllowsInPathSegment(unsigned int c) {
+    return (CharacterClasses::ComputeClasses(c) & CharacterClasses::PCHAR) != 0;
+}
+constexpr bool AllowsInPath(unsigned int c) {
+    return AllowsInPathSegment(c) || (c == '/');
+}
+constexpr bool AllowsInQueryComponent(unsigned int c) {
+    return (
+        ((CharacterClasses::ComputeClasses(c) & CharacterClasses::QUERY_OR_FRAGMENT) != 0)
+        && !CharacterClasses::IsOneOf(c, "&=+;")
+    );
+}
+constexpr bool AllowsInFragment(unsigned int c) {
+    return (CharacterClasses::ComputeClasses(c) & CharacterClasses::QUERY_OR_FRAGMENT) != 0;
+}
+
+/**
+ * This is the set of the characters which may appear as they are
+ * in user info: unreserved / sub-delims / ":"
+ */
+constexpr EncodeSet ENCODE_USER_INFO = MakeEncodeSet(AllowsInUserInfo);
+
+/**
+ * This is the set of the characters which may appear as they are in
+ * a single path segment, so that a "/" in it is percent-encoded:
+ * unreserved / sub-delims / ":" / "@"
+ */
+constexpr EncodeSet ENCODE_PATH_SEGMENT = MakeEncodeSet(AllowsInPathSegment);
+
+/**
+ * This is the set of the characters which may appear as they are in
+ * a whole path, where "/" separates the segments: pchar / "/"
+ */
+constexpr EncodeSet ENCODE_PATH = MakeEncodeSet(AllowsInPath);
+
+/**
+ * This is the set of the characters which may appear as they are in
+ * a key or value of a query parameter, so that the "&", "=", "+",
+ * and ";" which would otherwise split or change it are
+ * percent-encoded.
+ */
+constexpr EncodeSet ENCODE_QUERY_COMPONENT = MakeEncodeSet(AllowsInQueryComponent);
+
+/**
+ * This is the set of the characters which may appear as they are in a
+ * whole query or fragment: pchar / "/" / "?"
+ */
+constexpr EncodeSet ENCODE_FRAGMENT = MakeEncodeSet(AllowsInFragment);
+
+/**
+ * This function computes the number of characters which the given
+ * characters take up once percent-encoded, without encoding them.
+ *
+ * @param[in] data
+ *     This points to the characters to measure.
+ *
+ * @param[in] length
+ *     This is the number of characters to measure.
+ *
+ * @param[in] encodeSet
+ *     This is the set of characters which are not percent-encoded.
+ *
+ * @return
+ *     The number of characters the encoded characters
+ *     take up is returned.
+ */
+size_t PercentEncodedLength(
+    const char* data,
+    size_t length,
+    const EncodeSet& encodeSet
+);
+
+/**
+ * This function percent-encodes the given characters into the
+ * given buffer, with uppercase hexadecimal digits.
+ *
+ * Runs of characters which need no encoding are found many characters
+ * at a time, and copied in bulk.
+ *
+ * @param[in] data
+ *     This points to the characters to encode.
+ *
+ * @param[in] length
+ *     This is the number of characters to encode.
+ *
+ * @param[in] encodeSet
+ *     This is the set of characters which are not percent-encoded.
+ *
+ * @param[out] output
+ *     This points to where to put the encoded characters, which must
+ *     have room for the number returned by PercentEncodedLength, and
+ *     must not overlap the characters to encode.
+ *
+ * @return
+ *     The number of characters the encoded characters
+ *     take up is returned.
+ */
+size_t PercentEncode(
+    const char* data,
+    size_t length,
+    const EncodeSet& encodeSet,
+    char* output
+);
+
+/**
+ * This function percent-encodes the given characters, with uppercase
+ * hexadecimal digits, measuring them first so that the string is
+ * allocated only once, at the exact length it needs.
+ *
+ * @param[in] decoded
+ *     This is a view of the characters to encode.
+ *
+ * @param[in] encodeSet
+ *     This is the set of characters which are not percent-encoded.
+ *
+ * @return
+ *     The encoded characters are returned.
+ */
+std::string PercentEncode(
+    StringView decoded,
+    const EncodeSet& encodeSet
+);
+} // namespace Uri
+
+#endif /* URI_PERCENT_ENCODING_HPP */
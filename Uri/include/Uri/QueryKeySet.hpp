@@ -0,0 +1,545 @@
+#ifndef URI_QUERY_KEY_SET_HPP
+#define URI_QUERY_KEY_SET_HPP
+
+/**
+ * @file QueryKeySet.hpp
+ *
+ * This module declares the Uri::QueryKeySet class template, which
+ * picks the values of a fixed set of keys, known at compile time,
+ * out of a query in one pass, using a perfect hash of the keys
+ * built by the compiler.
+ */
+
+#include <Uri/CharacterClasses.hpp>
+#include <Uri/QueryParameters.hpp>
+#include <Uri/StringView.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace Uri
+{
+namespace QueryKeyHash
+{
+/**
+ * These are the odd constants, with bits well spread out,
+ * with which the hash is mixed.
+ */
+constexpr uint64_t LENGTH_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t SEED_MULTIPLIER = 0xa0761d6478bd642fULL;
+constexpr uint64_t WORD_MULTIPLIER = 0xbf58476d1ce4e5b9ULL;
+constexpr uint64_t FINISH_MULTIPLIER = 0x94d049bb133111ebULL;
+
+/**
+ * This function returns the length of the given string
+ * ending in a null character.
+ */
+constexpr size_t Length(const char *key) {
+  return (*key == '\0') ? 0 : 1 + Length(key + 1);
+}
+
+/**
+ * This function determines whether or not the given strings,
+ * ending in null characters, are the same.
+ */
+constexpr bool Same(const char *a, const char *b) {
+  return (*a == *b) && ((*a == '\0') || Same(a + 1, b + 1));
+}
+
+/**
+ * This function reads the given number of characters, no more
+ * than 8, as a little-endian word, the same on any machine.
+ */
+constexpr uint64_t Load(const char *data, size_t length) {
+  return (
+    (length == 0)
+    ? 0
+    : (
+      ((uint64_t)(unsigned char)data[length - 1] << (8 * (length - 1)))
+      | Load(data, length - 1)
+    )
+  );
+}
+
+/**
+ * This function reads the given number of characters, either 4 or 8,
+ * as a little-endian word, at run time, with one load where the
+ * machine is little-endian.  It is the same as Load.
+ */
+inline uint64_t LoadFast(const char *data, size_t length) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) \
+    || defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM64)
+  if (length == 8) {
+    uint64_t word;
+    memcpy(&word, data, 8);
+    return word;
+  } else {
+    uint32_t word;
+    memcpy(&word, data, 4);
+    return word;
+  }
+#else
+  return Load(data, length);
+#endif
+}
+
+/**
+ * This function spreads the high bits of the given
+ * word into its low bits.
+ */
+constexpr uint64_t Spread(uint64_t word, unsigned int shift) {
+  return word ^ (word >> shift);
+}
+
+/**
+ * This function mixes the given word into the given hash.
+ */
+constexpr uint64_t Absorb(uint64_t hash, uint64_t word) {
+  return Spread((hash ^ word) * WORD_MULTIPLIER, 32);
+}
+
+/**
+ * This function mixes every bit of the given hash
+ * into every other bit of it.
+ */
+constexpr uint64_t Finish(uint64_t hash) {
+  return Spread(Spread(Spread(hash, 30) * WORD_MULTIPLIER, 27) * FINISH_MULTIPLIER, 31);
+}
+
+/**
+ * This function returns the last word of a key of the given length,
+ * which is read in pieces of fixed size which may overlap, so that
+ * at run time there's no need to read a piece of any other size.
+ * A key of 8 or more characters has its last 8 characters read,
+ * including any already hashed.
+ */
+constexpr uint64_t LastWord(const char *key, size_t length) {
+  return (
+    (length >= 8) ? Load(key + length - 8, 8)
+    : (length >= 4) ? (Load(key, 4) | (Load(key + length - 4, 4) << 32))
+    : (length > 0) ? (
+      (uint64_t)(unsigned char)key[0]
+      | ((uint64_t)(unsigned char)key[length / 2] << 8)
+      | ((uint64_t)(unsigned char)key[length - 1] << 16)
+    )
+    : 0
+  );
+}
+
+/**
+ * This function returns the hash, before it's finished, of the given
+ * key, from the given position on, mixed into the given hash a word at
+ * a time, with the last word, of up to 8 characters, left to LastWord.
+ */
+constexpr uint64_t AbsorbAll(uint64_t hash, const char *key, size_t position, size_t length) {
+  return (
+    (length - position > 8)
+    ? AbsorbAll(Absorb(hash, Load(key + position, 8)), key, position + 8, length)
+    : Absorb(hash, LastWord(key, length))
+  );
+}
+
+/**
+ * This function returns the hash of the given key, with its given
+ * length, and with the given seed, at compile time.
+ */
+constexpr uint64_t HashConstant(const char *key, size_t length, uint64_t seed) {
+  return Finish(AbsorbAll((seed * SEED_MULTIPLIER) ^ (length * LENGTH_MULTIPLIER), key, 0, length));
+}
+
+/**
+ * This function returns the hash of the given key with the given
+ * seed, at compile time.  It is the same as that returned by Hash.
+ */
+constexpr uint64_t HashConstant(const char *key, uint64_t seed) {
+  return HashConstant(key, Length(key), seed);
+}
+
+/**
+ * This function returns the hash of the given key with the given
+ * seed, at run time.  It is the same as that returned by HashConstant.
+ */
+inline uint64_t Hash(StringView key, uint64_t seed) {
+  const char *const data = key.data();
+  const size_t length = key.size();
+  uint64_t hash = (seed * SEED_MULTIPLIER) ^ (length * LENGTH_MULTIPLIER);
+  size_t position = 0;
+  for (; length - position > 8; position += 8) {
+    hash = Absorb(hash, LoadFast(data + position, 8));
+  }
+  uint64_t last = 0;
+  if (length >= 8) {
+    last = LoadFast(data + length - 8, 8);
+  } else if (length >= 4) {
+    last = LoadFast(data, 4) | (LoadFast(data + length - 4, 4) << 32);
+  } else if (length > 0) {
+    last = (
+      (uint64_t)(unsigned char)data[0]
+      | ((uint64_t)(unsigned char)data[length / 2] << 8)
+      | ((uint64_t)(unsigned char)data[length - 1] << 16)
+    );
+  }
+  return Finish(Absorb(hash, last));
+}
+
+/**
+ * This function returns the number of keys given by the Keys type
+ * of a Uri::QueryKeySet.
+ */
+template< typename Keys > constexpr size_t NumKeys() {
+  return sizeof(Keys::keys) / sizeof(Keys::keys[0]);
+}
+
+/**
+ * This function returns the number of slots in the table of the keys
+ * given by the Keys type, a power of two at least four times the
+ * number of keys, so that a seed which puts every key in a slot of
+ * its own is found after trying only a few.
+ */
+template< typename Keys > constexpr size_t NumSlots() {
+  return (
+    (NumKeys< Keys >() <= 1) ? 4
+    : (NumKeys< Keys >() <= 2) ? 8
+    : (NumKeys< Keys >() <= 4) ? 16
+    : (NumKeys< Keys >() <= 8) ? 32
+    : (NumKeys< Keys >() <= 16) ? 64
+    : 128
+  );
+}
+
+/**
+ * This is the number of seeds tried before giving up.
+ */
+constexpr uint64_t MAX_SEEDS = 65536;
+
+/**
+ * This is returned when no seed works.
+ */
+constexpr uint64_t NO_SEED = ~(uint64_t)0;
+
+/**
+ * This function returns the key with the given number.
+ */
+template< typename Keys > constexpr const char *Key(size_t key) {
+  return Keys::keys[key];
+}
+
+/**
+ * This function returns the slot of the key with
+ * the given number, with the given seed.
+ */
+template< typename Keys > constexpr size_t SlotOf(size_t key, uint64_t seed) {
+  return (size_t)(HashConstant(Key< Keys >(key), seed) & (NumSlots< Keys >() - 1));
+}
+
+/**
+ * This function returns the number of the given key, looking from
+ * the key with the given number on, or the number of keys if
+ * it isn't there.
+ */
+template< typename Keys > constexpr size_t IndexOf(const char *key, size_t first) {
+  return (
+    (first >= NumKeys< Keys >()) ? NumKeys< Keys >()
+    : Same(Key< Keys >(first), key) ? first
+    : IndexOf< Keys >(key, first + 1)
+  );
+}
+
+/**
+ * This function determines whether or not any key, from the one
+ * with the given number on, is given again after it.
+ */
+template< typename Keys > constexpr bool HasDuplicates(size_t first) {
+  return (
+    (first < NumKeys< Keys >())
+    && (
+      (IndexOf< Keys >(Key< Keys >(first), first + 1) < NumKeys< Keys >())
+      || HasDuplicates< Keys >(first + 1)
+    )
+  );
+}
+
+/**
+ * This function determines whether or not the given key is in a
+ * different slot, with the given seed, from every key after it.
+ */
+template< typename Keys > constexpr bool InOwnSlot(uint64_t seed, size_t key, size_t other) {
+  return (
+    (other >= NumKeys< Keys >())
+    || (
+      (SlotOf< Keys >(key, seed) != SlotOf< Keys >(other, seed))
+      && InOwnSlot< Keys >(seed, key, other + 1)
+    )
+  );
+}
+
+/**
+ * This function determines whether or not every key, from the one
+ * with the given number on, is in a slot of its own with the given seed.
+ */
+template< typename Keys > constexpr bool IsPerfect(uint64_t seed, size_t key) {
+  return (
+    (key >= NumKeys< Keys >())
+    || (InOwnSlot< Keys >(seed, key, key + 1) && IsPerfect< Keys >(seed, key + 1))
+  );
+}
+
+template< typename Keys > constexpr uint64_t FindSeedIfNone(uint64_t found, uint64_t first, uint64_t count);
+
+/**
+ * This function returns the first seed in the given range which puts
+ * every key in a slot of its own, or NO_SEED if none does.  The range
+ * is split in halves, rather than tried one seed after another, so
+ * that the compiler doesn't recurse too deeply.
+ */
+template< typename Keys > constexpr uint64_t FindSeed(uint64_t first, uint64_t count) {
+  return (
+    (count == 1)
+    ? (IsPerfect< Keys >(first, 0) ? first : NO_SEED)
+    : FindSeedIfNone< Keys >(FindSeed< Keys >(first, count / 2), first + count / 2, count - count / 2)
+  );
+}
+
+template< typename Keys > constexpr uint64_t FindSeedIfNone(uint64_t found, uint64_t first, uint64_t count) {
+  return (found != NO_SEED) ? found : FindSeed< Keys >(first, count);
+}
+
+/**
+ * This holds the seed with which every key given by the Keys type
+ * hashes to a slot of its own, or NO_SEED if there isn't one.
+ */
+template< typename Keys > struct Seed {
+  static constexpr uint64_t value = (
+    HasDuplicates< Keys >(0) ? NO_SEED : FindSeed< Keys >(0, MAX_SEEDS)
+  );
+};
+template< typename Keys > constexpr uint64_t Seed< Keys >::value;
+
+/**
+ * This function returns the number of the key in the given slot,
+ * looking from the key with the given number on, or the number
+ * of keys if the slot is empty.
+ */
+template< typename Keys > constexpr size_t KeyInSlot(size_t slot, size_t key) {
+  return (
+    (key >= NumKeys< Keys >()) ? NumKeys< Keys >()
+    : (SlotOf< Keys >(key, Seed< Keys >::value) == slot) ? key
+    : KeyInSlot< Keys >(slot, key + 1)
+  );
+}
+
+/**
+ * This function returns the hash kept in the given slot.  An empty
+ * slot is given a hash which belongs in a different slot, so that
+ * no key's hash can ever match it.
+ */
+template< typename Keys > constexpr uint64_t HashInSlot(size_t slot) {
+  return (
+    (KeyInSlot< Keys >(slot, 0) < NumKeys< Keys >())
+    ? HashConstant(Key< Keys >(KeyInSlot< Keys >(slot, 0)), Seed< Keys >::value)
+    : (uint64_t)(slot ^ 1)
+  );
+}
+
+/**
+ * This holds the tables, built at compile time, of the slots of the
+ * keys given by the Keys type: the whole hash of the key in each
+ * slot, and its number.
+ */
+template< typename Keys, typename Slots > struct SlotTables;
+template< typename Keys, size_t... I >
+struct SlotTables< Keys, CharacterClasses::IndexSequence< I... > > {
+  static constexpr uint64_t hashes[sizeof...(I)] = {HashInSlot< Keys >(I)...};
+  static constexpr uint8_t keys[sizeof...(I)] = {(uint8_t)KeyInSlot< Keys >(I, 0)...};
+};
+template< typename Keys, size_t... I >
+constexpr uint64_t SlotTables< Keys, CharacterClasses::IndexSequence< I... > >::hashes[sizeof...(I)];
+template< typename Keys, size_t... I >
+constexpr uint8_t SlotTables< Keys, CharacterClasses::IndexSequence< I... > >::keys[sizeof...(I)];
+
+/**
+ * This holds the tables, built at compile time, of the keys given by
+ * the Keys type, and their lengths, with which a key of a query is
+ * confirmed in full when it has the same hash as one of them.
+ *
+ * Only these copies of the keys are used at run time, so that the
+ * Keys type needn't define its array outside of the class.
+ */
+template< typename Keys, typename Numbers > struct KeyTables;
+template< typename Keys, size_t... I >
+struct KeyTables< Keys, CharacterClasses::IndexSequence< I... > > {
+  static constexpr const char *keys[sizeof...(I)] = {Key< Keys >(I)...};
+  static constexpr size_t lengths[sizeof...(I)] = {Length(Key< Keys >(I))...};
+};
+template< typename Keys, size_t... I >
+constexpr const char *KeyTables< Keys, CharacterClasses::IndexSequence< I... > >::keys[sizeof...(I)];
+template< typename Keys, size_t... I >
+constexpr size_t KeyTables< Keys, CharacterClasses::IndexSequence< I... > >::lengths[sizeof...(I)];
+
+/**
+ * These functions, which are never called, give the types
+ * of the tables for the given sequences of numbers.
+ */
+template< typename Keys, size_t... I >
+SlotTables< Keys, CharacterClasses::IndexSequence< I... > > SlotTablesFor(CharacterClasses::IndexSequence< I... >);
+template< typename Keys, size_t... I >
+KeyTables< Keys, CharacterClasses::IndexSequence< I... > > KeyTablesFor(CharacterClasses::IndexSequence< I... >);
+} // namespace QueryKeyHash
+
+/**
+ * This class template picks the values of a fixed set of keys out of
+ * a query, such as the "utm_" parameters an analytics pipeline needs
+ * from every URL, in one pass over the query.
+ *
+ * The keys are given by the Keys type, which has them as a static
+ * array, in the order in which their values are wanted:
+ *
+ *     struct CampaignKeys {
+ *         static constexpr const char *keys[] = {
+ *             "utm_source", "utm_medium", "utm_campaign", "gclid",
+ *         };
+ *     };
+ *     const auto values = Uri::QueryKeySet< CampaignKeys >::Extract(query);
+ *
+ * The compiler searches for a seed with which every key hashes to a
+ * different slot of a small table, and stores the whole hash of each
+ * key in its slot.  Each key of the query is then hashed once, and
+ * unless its hash is the one in its slot, which it almost never is
+ * for a key not in the set, it's passed over without comparing any
+ * characters.
+ *
+ * Keys are matched as they're written in the query, without decoding.
+ */
+template< typename Keys > class QueryKeySet
+{
+  // Types
+public:
+  /**
+   * This is the number of keys in the set.
+   */
+  static constexpr size_t NUM_KEYS = QueryKeyHash::NumKeys< Keys >();
+
+  /**
+   * These are the values found for the keys of the set.
+   *
+   * @note
+   *     The views are only valid until the query from which they were
+   *     obtained is changed or destroyed.
+   */
+  struct Values {
+    // Properties
+
+    /**
+     * These are the values of the keys, in the order the keys are
+     * given, each empty if its key wasn't found or had no value.
+     */
+    StringView values[NUM_KEYS];
+
+    /**
+     * This has a bit set, in the order the keys are given, for each
+     * key which was found, so that a key without a value can be
+     * told apart from one which isn't there.
+     */
+    uint64_t found = 0;
+
+    // Methods
+
+    /**
+     * This returns the value of the key with the given number.
+     */
+    StringView operator[](size_t key) const { return values[key]; }
+
+    /**
+     * This returns an indication of whether or not the key
+     * with the given number was found.
+     */
+    bool Has(size_t key) const { return ((found >> key) & 1) != 0; }
+  };
+
+  // Public methods
+public:
+  /**
+   * This function finds the values of the keys of the set in the
+   * given query.  Where a key appears more than once, the first
+   * value is the one found, the same as Uri::GetQueryParameter.
+   *
+   * @param[in] query
+   *     This is the query, without the leading question mark.
+   *
+   * @return
+   *     The values of the keys of the set are returned.
+   */
+  static Values Extract(StringView query)
+  {
+    Values values;
+    for (const auto &parameter : QueryParameters(query)) {
+      const uint64_t hash = QueryKeyHash::Hash(parameter.key, SEED);
+      const size_t slot = (size_t)(hash & (NUM_SLOTS - 1));
+      if (Slots::hashes[slot] != hash) {
+        continue;
+      }
+      const size_t key = Slots::keys[slot];
+      if (
+        (parameter.key.size() == Known::lengths[key])
+        && (memcmp(parameter.key.data(), Known::keys[key], parameter.key.size()) == 0)
+        && !values.Has(key)
+      ) {
+        values.values[key] = parameter.value;
+        values.found |= (uint64_t)1 << key;
+        if (values.found == ALL_FOUND) {
+          break;
+        }
+      }
+    }
+    return values;
+  }
+
+  /**
+   * This function returns the number of the given key in the set,
+   * or NUM_KEYS if it isn't in the set.  It can be used at compile
+   * time, to name the values found by their keys.
+   */
+  static constexpr size_t IndexOf(const char *key)
+  {
+    return QueryKeyHash::IndexOf< Known >(key, 0);
+  }
+
+  // Private properties
+private:
+  static_assert(NUM_KEYS <= 32, "a query key set can have at most 32 keys");
+  static_assert(
+    !QueryKeyHash::HasDuplicates< Keys >(0),
+    "a query key set can't have the same key more than once"
+  );
+
+  /**
+   * This is the number of slots in the table of the keys.
+   */
+  static constexpr size_t NUM_SLOTS = QueryKeyHash::NumSlots< Keys >();
+
+  /**
+   * This is the seed with which every key hashes to a slot of its own.
+   */
+  static constexpr uint64_t SEED = QueryKeyHash::Seed< Keys >::value;
+  static_assert(SEED != QueryKeyHash::NO_SEED, "no perfect hash was found for the keys of a query key set");
+
+  /**
+   * This is the value of the found bits of Values
+   * once every key has been found.
+   */
+  static constexpr uint64_t ALL_FOUND = ((uint64_t)1 << NUM_KEYS) - 1;
+
+  /**
+   * These are the tables of the slots, and of the keys.
+   */
+  using Slots = decltype(
+    QueryKeyHash::SlotTablesFor< Keys >(CharacterClasses::MakeIndexSequence< NUM_SLOTS >())
+  );
+  using Known = decltype(
+    QueryKeyHash::KeyTablesFor< Keys >(CharacterClasses::MakeIndexSequence< NUM_KEYS >())
+  );
+};
+} // namespace Uri
+
+#endif /* URI_QUERY_KEY_SET_HPP */
@@ -0,0 +1,259 @@
+#ifndef URI_QUERY_PARAMETERS_HPP
+#define URI_QUERY_PARAMETERS_HPP
+
+/**
+ * @file QueryParameters.hpp
+ *
+ * This module declares the Uri::QueryParameters class, and the
+ * Uri::QueryParameter structure which it hands out.
+ */
+
+#include <Uri/PercentEncoding.hpp>
+#include <Uri/StringView.hpp>
+
+#include <iterator>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Uri
+{
+/**
+ * This is one parameter of a query, such as "lang=en", as it's
+ * written, split into its key and value.
+ *
+ * @note
+ *     The views are only valid until the query from which they were
+ *     obtained is changed or destroyed.
+ */
+struct QueryParameter {
+  // Properties
+
+  /**
+   * This is the key of the parameter, which is everything
+   * before the first "=", or the whole parameter if there's none.
+   */
+  StringView key;
+
+  /**
+   * This is the value of the parameter, which is everything after
+   * the first "=", or empty if there's none.
+   */
+  StringView value;
+
+  /**
+   * This indicates whether or not the parameter has an "=",
+   * so that "flag" and "flag=" can be told apart.
+   */
+  bool hasValue = false;
+
+  // Methods
+
+  /**
+   * This method decodes the key of the parameter, only if it needs
+   * it (see PercentDecodeView).
+   *
+   * @param[in,out] scratch
+   *     This is where to put the decoded characters, if they
+   *     need to be put anywhere.
+   *
+   * @param[out] decoded
+   *     This is where to put the view of the decoded characters.
+   *
+   * @param[in] options
+   *     These are the DECODE_ options to apply.  By default, "+"
+   *     is decoded as a space, as in an HTML form submission.
+   *
+   * @return
+   *     The number of characters decoded, or why they couldn't be
+   *     decoded and where, is returned.
+   */
+  DecodeResult DecodeKey(
+    std::string &scratch,
+    StringView &decoded,
+    unsigned int options = DECODE_PLUS_AS_SPACE
+  ) const {
+    return PercentDecodeView(key, scratch, decoded, options);
+  }
+
+  /**
+   * This method decodes the value of the parameter, only if it needs
+   * it (see DecodeKey).
+   */
+  DecodeResult DecodeValue(
+    std::string &scratch,
+    StringView &decoded,
+    unsigned int options = DECODE_PLUS_AS_SPACE
+  ) const {
+    return PercentDecodeView(value, scratch, decoded, options);
+  }
+};
+
+/**
+ * This class is a non-owning view of the parameters of a query,
+ * separated by "&", each with its key and value separated by the
+ * first "=", such as "lang=en&page=3".  Empty parameters, as in
+ * "a&&b", are skipped.
+ *
+ * The parameters are found one at a time, as the view is iterated,
+ * by searching the query for "&" and "=" many characters at a time.
+ * Nothing is copied or decoded until asked for.
+ *
+ * @note
+ *     The view, and the parameters it hands out, are only valid until
+ *     the query from which they were obtained is changed or destroyed.
+ */
+class QueryParameters
+{
+  // Types
+public:
+  /**
+   * This is the type of iterator over the parameters.
+   */
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = QueryParameter;
+    using difference_type = ptrdiff_t;
+    using pointer = const QueryParameter *;
+    using reference = const QueryParameter &;
+
+    Iterator() = default;
+
+    const QueryParameter &operator*() const { return parameter_; }
+    const QueryParameter *operator->() const { return &parameter_; }
+    Iterator &operator++() { Advance(); return *this; }
+    Iterator operator++(int) { Iterator old(*this); Advance(); return old; }
+    bool operator==(const Iterator &other) const { return position_ == other.position_; }
+    bool operator!=(const Iterator &other) const { return position_ != other.position_; }
+
+  private:
+    friend class QueryParameters;
+
+    /**
+     * This constructs an iterator over the given query, which is
+     * at the end of the query until it's advanced.
+     */
+    Iterator(const char *query, size_t length)
+        : query_(query)
+        , length_(length)
+        , position_(length + 1)
+    {
+    }
+
+    /**
+     * This method moves the iterator to the next parameter which
+     * isn't empty, or to the end of the query if there are no more.
+     */
+    void Advance();
+
+    /**
+     * This method finds the first "&" or "=" in the query at or after
+     * the given position, searching a block of characters at a time.
+     *
+     * @return
+     *     The position of the first "&" or "=" is returned, or the
+     *     length of the query if there are none.
+     */
+    size_t FindSeparator(size_t position);
+
+    /**
+     * This points to the characters of the query.
+     */
+    const char *query_ = nullptr;
+
+    /**
+     * This is the number of characters of the query.
+     */
+    size_t length_ = 0;
+
+    /**
+     * This is where the current parameter begins, or one past the
+     * end of the query if the iterator is at the end.
+     */
+    size_t position_ = 1;
+
+    /**
+     * This is where to look for the next parameter.
+     */
+    size_t next_ = 0;
+
+    /**
+     * This is where the block of characters last searched begins.
+     */
+    size_t blockBegin_ = 0;
+
+    /**
+     * This is where the block of characters last searched ends.
+     */
+    size_t blockEnd_ = 0;
+
+    /**
+     * This has a bit set for each "&" or "=" in the block of
+     * characters last searched.
+     */
+    uint64_t mask_ = 0;
+
+    /**
+     * This is the current parameter.
+     */
+    QueryParameter parameter_;
+  };
+
+  using value_type = QueryParameter;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  // Public methods
+public:
+  /**
+   * This is the default constructor, which makes a view
+   * with no parameters.
+   */
+  QueryParameters() = default;
+
+  /**
+   * This constructs a view of the parameters of the given query.
+   *
+   * @param[in] query
+   *     This is the query, without the leading question mark.
+   */
+  explicit QueryParameters(StringView query)
+      : query_(query)
+  {
+  }
+
+  /**
+   * This returns the whole query.
+   */
+  StringView GetQuery() const { return query_; }
+
+  /**
+   * This returns an iterator to the first parameter.
+   */
+  Iterator begin() const
+  {
+    Iterator first(query_.data(), query_.size());
+    first.Advance();
+    return first;
+  }
+
+  /**
+   * This returns an iterator past the last parameter.
+   */
+  Iterator end() const { return Iterator(query_.data(), query_.size()); }
+
+  /**
+   * This returns an indication of whether or not there are
+   * no parameters.
+   */
+  bool empty() const { return begin() == end(); }
+
+  // Private properties
+private:
+  StringView query_;
+};
+} // namespace Uri
+
+#endif /* URI_QUERY_PARAMETERS_HPP */
@@ -0,0 +1,137 @@
+#ifndef URI_STREAMING_PARSER_HPP
+#define URI_STREAMING_PARSER_HPP
+
+/**
+ * @file StreamingParser.hpp
+ *
+ * This module declares the Uri::StreamingParser class.
+ */
+
+#include <Uri/UriView.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+/**
+ * This class parses a Uniform Resource Identifier (URI), as defined
+ * in RFC 3986 (https://tools.ietf.org/html/rfc3986), which arrives
+ * in pieces, such as the request target of an HTTP request read from
+ * a socket, without the pieces having to be gathered together first.
+ *
+ * Each character is looked at once, as it's fed to the parser, which
+ * keeps its place in the grammar between pieces.  Input which can't
+ * be the start of a valid URI is rejected as soon as the character
+ * which makes it so is fed.
+ *
+ * The pieces aren't kept, so the elements of the URI are given as
+ * offsets, counted from the first character of the first piece.
+ */
+class StreamingParser
+{
+  // Lifecycle management
+public:
+  ~StreamingParser();
+  StreamingParser(const StreamingParser &other);
+  StreamingParser &operator=(const StreamingParser &other);
+
+  // Public methods
+public:
+  /**
+   * This is the default constructor, which makes a parser
+   * ready for the first piece of a URI.
+   */
+  StreamingParser();
+
+  /**
+   * This method makes the parser ready for the first piece
+   * of a new URI.
+   */
+  void Reset();
+
+  /**
+   * This method parses the next piece of the URI.
+   *
+   * @param[in] data
+   *     This points to the characters of the piece, which need not
+   *     outlive the call.
+   *
+   * @param[in] length
+   *     This is the number of characters in the piece.
+   *
+   * @return
+   *     An indication of whether or not the characters fed so far
+   *     could be the start of a valid URI is returned.  Once this
+   *     is false, it stays false until the parser is reset.
+   */
+  bool Feed(const char *data, size_t length);
+
+  /**
+   * This method tells the parser that the whole URI has been fed,
+   * completing the parse.
+   *
+   * @return
+   *     An indication of whether or not the characters fed
+   *     make up a valid URI is returned.
+   */
+  bool Finish();
+
+  /**
+   * This method returns an indication of whether or not the
+   * characters fed so far have been found not to be a valid URI.
+   */
+  bool HasFailed() const;
+
+  /**
+   * This method returns where the character was found which made
+   * the input not a valid URI, if the parser has failed.  This is
+   * the number of characters fed if the input ended too soon.
+   */
+  size_t GetErrorOffset() const;
+
+  /**
+   * This method returns the number of characters fed so far which
+   * were parsed.  Once the parser has failed, this stops growing.
+   */
+  size_t GetConsumed() const;
+
+  /**
+   * These methods return which elements the URI has, and where each
+   * element is located.
+   *
+   * @note
+   *     These are only meaningful once Finish has returned true.
+   */
+  bool HasScheme() const;
+  bool HasAuthority() const;
+  bool HasUserInfo() const;
+  bool HasPort() const;
+  bool HasQuery() const;
+  bool HasFragment() const;
+  uint16_t GetPort() const;
+  UriView::Range GetSchemeRange() const;
+  UriView::Range GetUserInfoRange() const;
+  UriView::Range GetHostRange() const;
+  UriView::Range GetPathRange() const;
+  UriView::Range GetQueryRange() const;
+  UriView::Range GetFragmentRange() const;
+
+  // Private properties
+private:
+  /**
+   * This is the number of bytes set aside inside each instance
+   * for the state machine.
+   */
+  static constexpr size_t STORAGE_SIZE = 192;
+
+  /**
+   * This holds the state machine in place, so that making a parser
+   * doesn't go to the heap, and so that how the state machine is
+   * laid out isn't part of the interface.
+   */
+  alignas(8) unsigned char storage_[STORAGE_SIZE];
+};
+} // namespace Uri
+
+#endif /* URI_STREAMING_PARSER_HPP */
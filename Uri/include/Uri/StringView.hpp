@@ -0,0 +1,224 @@
+#ifndef URI_STRING_VIEW_HPP
+#define URI_STRING_VIEW_HPP
+
+/**
+ * @file StringView.hpp
+ *
+ * This module declares the Uri::StringView class.
+ */
+
+#include <ostream>
+#include <stddef.h>
+#include <string>
+#include <string.h>
+
+namespace Uri
+{
+/**
+ * This class is a non-owning reference to a contiguous sequence
+ * of characters, used to hand out pieces of a URI without copying
+ * them.  It is a small stand-in for std::string_view, which is not
+ * available in C++11.
+ *
+ * @note
+ *     The characters referenced by a view are owned by someone else,
+ *     and must outlive the view.
+ */
+class StringView
+{
+  // Public methods
+public:
+  /**
+   * This is the default constructor, which makes an empty view.
+   */
+  StringView()
+      : data_(nullptr), size_(0)
+  {
+  }
+
+  /**
+   * This constructs a view of the given characters.
+   *
+   * @param[in] data
+   *     This points to the first character of the view.
+   *
+   * @param[in] size
+   *     This is the number of characters in the view.
+   */
+  StringView(const char *data, size_t size)
+      : data_(data), size_(size)
+  {
+  }
+
+  /**
+   * This constructs a view of the given C string.
+   *
+   * @param[in] cString
+   *     This is the null-terminated string to view.
+   */
+  StringView(const char *cString)
+      : data_(cString), size_(strlen(cString))
+  {
+  }
+
+  /**
+   * This constructs a view of the given string.
+   *
+   * @param[in] string
+   *     This is the string to view.
+   */
+  StringView(const std::string &string)
+      : data_(string.data()), size_(string.size())
+  {
+  }
+
+  /**
+   * This returns a pointer to the first character of the view.
+   */
+  const char *data() const { return data_; }
+
+  /**
+   * This returns the number of characters in the view.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * This returns the number of characters in the view.
+   */
+  size_t length() const { return size_; }
+
+  /**
+   * This returns an indication of whether or not the view is empty.
+   */
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * This returns an iterator to the first character of the view.
+   */
+  const char *begin() const { return data_; }
+
+  /**
+   * This returns an iterator past the last character of the view.
+   */
+  const char *end() const { return data_ + size_; }
+
+  /**
+   * This returns the character at the given index in the view.
+   */
+  char operator[](size_t index) const { return data_[index]; }
+
+  /**
+   * This returns a view of part of this view.
+   *
+   * @param[in] position
+   *     This is the index of the first character of the part.
+   *
+   * @param[in] count
+   *     This is the maximum number of characters in the part.
+   *
+   * @return
+   *     A view of the requested part is returned.
+   */
+  StringView substr(size_t position, size_t count = std::string::npos) const
+  {
+    if (position > size_) {
+      position = size_;
+    }
+    if (count > size_ - position) {
+      count = size_ - position;
+    }
+    return StringView(data_ + position, count);
+  }
+
+  /**
+   * This makes a copy of the characters in the view.
+   *
+   * @return
+   *     An owning copy of the characters in the view is returned.
+   */
+  std::string ToString() const
+  {
+    return std::string(data_, size_);
+  }
+
+  /**
+   * This makes a copy of the characters in the view.
+   */
+  operator std::string() const
+  {
+    return ToString();
+  }
+
+  // Private properties
+private:
+  /**
+   * This points to the first character of the view.
+   */
+  const char *data_;
+
+  /**
+   * This is the number of characters in the view.
+   */
+  size_t size_;
+};
+
+inline bool operator==(const StringView &lhs, const StringView &rhs)
+{
+  return (
+    (lhs.size() == rhs.size())
+    && ((lhs.size() == 0) || (memcmp(lhs.data(), rhs.data(), lhs.size()) == 0))
+  );
+}
+
+inline bool operator!=(const StringView &lhs, const StringView &rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator==(const StringView &lhs, const std::string &rhs)
+{
+  return lhs == StringView(rhs);
+}
+
+inline bool operator==(const std::string &lhs, const StringView &rhs)
+{
+  return StringView(lhs) == rhs;
+}
+
+inline bool operator!=(const StringView &lhs, const std::string &rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(const std::string &lhs, const StringView &rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator==(const StringView &lhs, const char *rhs)
+{
+  return lhs == StringView(rhs);
+}
+
+inline bool operator==(const char *lhs, const StringView &rhs)
+{
+  return StringView(lhs) == rhs;
+}
+
+inline bool operator!=(const StringView &lhs, const char *rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator!=(const char *lhs, const StringView &rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline std::ostream &operator<<(std::ostream &stream, const StringView &view)
+{
+  return stream.write(view.data(), (std::streamsize)view.size());
+}
+} // namespace Uri
+
+#endif /* URI_STRING_VIEW_HPP */
@@ -1,16 +1,28 @@
+#ifndef URI_URI_HPP
+#define URI_URI_HPP
+
 /**
  * @file Uri.hpp
  * 
  * This module declares the Uri::Uri class.
  */
 
+#include <Uri/PathSegments.hpp>
+#include <Uri/QueryParameters.hpp>
+#include <Uri/StringView.hpp>
+
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
+#include <stddef.h>
 #include <stdint.h>
 
 namespace Uri
 {
+struct Fingerprint128;
+struct FingerprintOptions;
+
   /**
     * This class represents a Uniform Resource Identifier (URI),
     * as defined in RFC 3986 (https://tools.ietf.org/html/rfc3986).
@@ -20,10 +32,33 @@ class Uri
   // Lifecycle management
 public:
   ~Uri();
-  Uri(const Uri &) = delete;
-  Uri(Uri &&) = delete;
-  Uri &operator=(const Uri &) = delete;
-  Uri &operator=(Uri &&) = delete;
+
+  /**
+   * This is the copy constructor, which makes a deep copy
+   * of the given URI.
+   */
+  Uri(const Uri &other);
+
+  /**
+   * This is the move constructor, which takes over the elements
+   * of the given URI without copying them.  The given URI is left
+   * empty, as if it had just been constructed, and may be reused.
+   */
+  Uri(Uri &&other) noexcept;
+
+  /**
+   * This is the copy assignment operator, which makes a deep copy
+   * of the given URI.
+   */
+  Uri &operator=(const Uri &other);
+
+  /**
+   * This is the move assignment operator, which takes over the
+   * elements of the given URI without copying them.  The given URI
+   * is left empty, as if it had just been constructed, and may be
+   * reused.
+   */
+  Uri &operator=(Uri &&other) noexcept;
 
   // Public methods
 public:
@@ -49,37 +84,41 @@ public:
    * This method gets the "scheme" element of the URI.
    * 
    * @return
-   *     A string represents the "scheme" of the URI.
+   *     A view of the "scheme" of the URI is returned, which is
+   *     valid until the URI is changed or destroyed.
    *
    * @retval
-   *     An empty string if the URI has no scheme.
+   *     An empty view if the URI has no scheme.
    */
-  std::string GetScheme() const;
+  StringView GetScheme() const;
 
   /**
    * This method gets the "host" element of the URI.
    * 
    * @return
-   *     A string represents the "host" of the URI.
+   *     A view of the "host" of the URI is returned, which is
+   *     valid until the URI is changed or destroyed.
    *
    * @retval
-   *     An empty string if the URI has no host.
+   *     An empty view if the URI has no host.
    */
-  std::string GetHost() const;
+  StringView GetHost() const;
 
   /**
-   * This method gets the "path" of the URI, which is
-   * stored as a vector of strings.
+   * This method gets the "path" of the URI, as its sequence of
+   * segments.  No copies are made; the segments are read straight
+   * out of the URI, and converting the result to a
+   * std::vector< std::string > makes a copy of them.
    * 
    * @return
-   *     A vector of strings represents the path of
-   *     the URI.
+   *     A view of the segments of the path of the URI is returned,
+   *     which is valid until the URI is changed or destroyed.
    *
    * @note
    *     If the first step of the path is an empty string,
    *     then the URI has an absolute path. 
    */ 
-  std::vector< std::string > GetPath() const;
+  PathSegments GetPath() const;
 
   /**
    * This method returns an indication of whether or not the URI
@@ -128,35 +167,223 @@ public:
    * This method gets the "query" element of the URI.
    * 
    * @return
-   *     A string represents the "query" of the URI.
+   *     A view of the "query" of the URI is returned, which is
+   *     valid until the URI is changed or destroyed.
+   *
+   * @retval
+   *     An empty view if the URI has no query.
+   */
+  StringView GetQuery() const;
+
+  /**
+   * This method gets the parameters of the "query" element of the
+   * URI, such as "lang" and "en" from "lang=en&page=3", found as
+   * they're iterated, without copying or decoding them.
+   *
+   * @return
+   *     A view of the parameters of the query is returned, which is
+   *     valid until the URI is changed or destroyed.
+   */
+  QueryParameters GetQueryParameters() const;
+
+  /**
+   * This method returns an indication of whether or not the query
+   * of the URI has a parameter with the given key (see
+   * GetQueryParameter).
+   *
+   * @param[in] key
+   *     This is the key to find, as it's written in the query.
+   *
+   * @return
+   *     An indication of whether or not the query has a parameter
+   *     with the given key is returned.
+   */
+  bool HasQueryParameter(const StringView &key) const;
+
+  /**
+   * This method gets the value of the first parameter of the query
+   * of the URI with the given key, as it's written in the query.
+   *
+   * Keys are matched as they're written, without decoding them.  The
+   * first lookup in a long query builds an index of its parameters,
+   * which later lookups use to go straight to the parameter, and which
+   * is thrown away when the URI changes; a short query is simply
+   * searched on every lookup, which is faster for it.  Like the other
+   * methods which don't change the URI, this may be called from more
+   * than one thread at once.
+   *
+   * @param[in] key
+   *     This is the key to find, as it's written in the query.
+   *
+   * @return
+   *     A view of the value of the parameter is returned, which is
+   *     valid until the URI is changed or destroyed.
    *
    * @retval
-   *     An empty string if the URI has no query.
+   *     An empty view if the query has no parameter
+   *     with the given key.
    */
-  std::string GetQuery() const;
+  StringView GetQueryParameter(const StringView &key) const;
+
+  /**
+   * This method gets the values of all the parameters of the query
+   * of the URI with the given key, in the order they appear, such as
+   * "1" and "2" for "id" in "id=1&x=y&id=2" (see GetQueryParameter).
+   *
+   * @param[in] key
+   *     This is the key to find, as it's written in the query.
+   *
+   * @return
+   *     Views of the values of the parameters are returned, which are
+   *     valid until the URI is changed or destroyed.
+   */
+  std::vector< StringView > GetAllQueryParameters(const StringView &key) const;
 
   /**
    * This method gets the "fragment" element of the URI.
    * 
    * @return
-   *     A string represents the "fragment" of the URI.
+   *     A view of the "fragment" of the URI is returned, which is
+   *     valid until the URI is changed or destroyed.
    *
    * @retval
-   *     An empty string if the URI has no fragment.
+   *     An empty view if the URI has no fragment.
    */
-  std::string GetFragment() const;
+  StringView GetFragment() const;
 
   /**
    * This method gets the "user info" element of the URI.
    * 
    * @return
-   *     A string represents the "user info" of the URI.
+   *     A view of the "user info" of the URI is returned, which is
+   *     valid until the URI is changed or destroyed.
    *
    * @retval
-   *     An empty string if the URI has no user info.
+   *     An empty view if the URI has no user info.
+   */
+  StringView GetUserInfo() const;
+
+  /**
+   * This method returns the number of characters which
+   * GenerateString produces for the URI.
    */
-  std::string GetUserInfo() const;
-  
+  size_t GetStringLength() const;
+
+  /**
+   * This method renders the URI as a string, by putting its elements
+   * back together as described in RFC 3986 section 5.3.  An empty
+   * port is left out, and a port is written without leading zeros;
+   * everything else is as it was parsed.
+   *
+   * The length is known ahead of time from where the elements are,
+   * so the string is allocated only once.
+   *
+   * @return
+   *     The URI rendered as a string is returned.
+   */
+  std::string GenerateString() const;
+
+  /**
+   * This method renders the URI, as GenerateString does, into the
+   * given buffer, without allocating any memory.  No terminating
+   * null character is written.
+   *
+   * @param[out] buffer
+   *     This points to where to put the characters of the URI.
+   *
+   * @param[in] size
+   *     This is the number of characters the buffer can hold.
+   *
+   * @return
+   *     The number of characters the URI takes up is returned.
+   *     If this is more than the given size, nothing is written.
+   */
+  size_t GenerateString(char* buffer, size_t size) const;
+
+  /**
+   * This method normalizes the URI, as described in RFC 3986 section
+   * 6.2.2, so that URIs which differ only in how they're written, such
+   * as "HTTP://Example.COM:80/a/./b/%7e" and "http://example.com/a/b/~",
+   * become the same:
+   *
+   * - The scheme and host are made lowercase.
+   * - The hexadecimal digits of percent-encoded octets
+   *   are made uppercase.
+   * - Percent-encoded unreserved characters are decoded.
+   * - The dot segments of the path are removed, if the URI
+   *   has a scheme.
+   * - An empty port, or the default port of a well-known scheme such
+   *   as http, is left out, and an empty path of such a scheme is
+   *   made "/" (section 6.2.3).
+   *
+   * The elements already found by parsing are rewritten in one pass
+   * into a new buffer, without rendering and parsing the URI again.
+   */
+  void Normalize();
+
+  /**
+   * This is the equality comparison operator for the class.
+   *
+   * Two URIs are equal if they have the same elements, written the
+   * same way, which is when they render as the same string.  The
+   * elements are compared one by one, where they are, stopping at
+   * the first one which differs, so nothing is copied or allocated.
+   *
+   * @param[in] other
+   *     This is the other URI to which to compare this URI.
+   *
+   * @return
+   *     An indication of whether or not the two URIs are equal
+   *     is returned.
+   */
+  bool operator==(const Uri &other) const;
+
+  /**
+   * This is the inequality comparison operator for the class.
+   *
+   * @param[in] other
+   *     This is the other URI to which to compare this URI.
+   *
+   * @return
+   *     An indication of whether or not the two URIs are not equal
+   *     is returned.
+   */
+  bool operator!=(const Uri &other) const;
+
+  /**
+   * This is the less-than comparison operator for the class, which
+   * orders URIs element by element: scheme, user info, host, port,
+   * path, query, and then fragment.  An element a URI doesn't have
+   * comes before any element it does have, even an empty one.
+   *
+   * @param[in] other
+   *     This is the other URI to which to compare this URI.
+   *
+   * @return
+   *     An indication of whether or not this URI comes before
+   *     the other one is returned.
+   */
+  bool operator<(const Uri &other) const;
+
+  /**
+   * This method determines whether or not this URI is the same as
+   * the given one once both are normalized, as by Normalize, such as
+   * "HTTP://Example.COM:80/%7ejoe" and "http://example.com/~joe".
+   *
+   * Neither URI is normalized, or changed at all.  The elements are
+   * compared as they're read, ignoring case where RFC 3986 allows and
+   * decoding percent-encoded unreserved characters, stopping at the
+   * first difference.
+   *
+   * @param[in] other
+   *     This is the other URI to which to compare this URI.
+   *
+   * @return
+   *     An indication of whether or not the two URIs are equivalent
+   *     is returned.
+   */
+  bool EquivalentTo(const Uri &other) const;
+
   // Private properties
 private:
   /**
@@ -166,14 +393,92 @@ private:
     */
   struct Impl;
 
+#if defined(URI_PIMPL)
   /**
     * This contains the private properties of the instance.
     */
   std::unique_ptr<struct Impl> impl_;
+#else
+  /**
+   * This is the number of bytes set aside inside each instance
+   * for its private properties.
+   */
+  static constexpr size_t INLINE_STORAGE_SIZE = 256;
+
+  /**
+   * This holds the private properties of the instance in place,
+   * so that constructing a URI, and parsing a typical one,
+   * doesn't go to the heap.
+   */
+  alignas(8) unsigned char storage_[INLINE_STORAGE_SIZE];
+#endif
 
   /**
    * This method resets the data of Uri before parse a new Uri string.
    */
   void reset_impl();
+
+  /**
+   * This method returns the private properties of the instance,
+   * which are those of an empty URI if the instance was moved from.
+   */
+  const Impl &impl() const;
+
+  /**
+   * This method returns the private properties of the instance,
+   * for changing them, first giving it those of an empty URI
+   * if the instance was moved from.
+   */
+  Impl &impl();
+
+  /**
+   * This puts the target URI together straight in the private
+   * properties of the instance it returns.
+   */
+  friend Uri Resolve(const Uri& base, const Uri& reference);
+
+  /**
+   * This hashes the elements of the URI straight out of
+   * the private properties of the instance.
+   */
+  friend void Fingerprint(
+    const Uri& uri,
+    const FingerprintOptions& options,
+    Fingerprint128& fingerprint
+  );
+};
+
+/**
+ * This function resolves a URI reference against a base URI, as
+ * described in RFC 3986 section 5.2, to find the URI it refers to.
+ *
+ * The target URI is put together in its own buffer as it's worked out,
+ * and the dot segments of its path are removed right there in place,
+ * so nothing else is allocated along the way.
+ *
+ * @param[in] base
+ *     This is the base URI, which should have a scheme.
+ *
+ * @param[in] reference
+ *     This is the URI reference to resolve.
+ *
+ * @return
+ *     The target URI, which the reference refers to, is returned.
+ */
+Uri Resolve(const Uri& base, const Uri& reference);
+} // namespace Uri
+
+namespace std
+{
+/**
+ * This hashes a URI, so that URIs can be used as keys of unordered
+ * containers.  Every element of the URI goes into the hash, normalized
+ * as by Uri::Uri::Normalize, so URIs which are the same have the
+ * same hash.
+ */
+template<> struct hash< Uri::Uri > {
+  size_t operator()(const Uri::Uri &uri) const noexcept;
 };
-} // namespace Uri
\ No newline at end of file
+} // namespace std
+
+#endif /* URI_URI_HPP */
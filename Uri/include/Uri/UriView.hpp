@@ -0,0 +1,262 @@
+#ifndef URI_URI_VIEW_HPP
+#define URI_URI_VIEW_HPP
+
+/**
+ * @file UriView.hpp
+ *
+ * This module declares the Uri::UriView class.
+ */
+
+#include <Uri/QueryParameters.hpp>
+#include <Uri/StringView.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Uri
+{
+/**
+ * This class is a non-owning, allocation-free parse of a
+ * Uniform Resource Identifier (URI), as defined in RFC 3986
+ * (https://tools.ietf.org/html/rfc3986).  Only URI-references
+ * which follow the grammar of RFC 3986 are accepted.
+ *
+ * Instead of copying the elements of the URI, it records where
+ * each element begins and ends in the parsed characters, and hands
+ * out views of them.
+ *
+ * @note
+ *     The parsed characters are not copied, and must outlive the
+ *     view and everything obtained from it.
+ */
+class UriView
+{
+  // Types
+public:
+  /**
+   * This identifies a span of the parsed characters by the offsets
+   * of its first character and of the character just past its end.
+   */
+  struct Range {
+    size_t begin = 0;
+    size_t end = 0;
+
+    /**
+     * This returns the number of characters in the span.
+     */
+    size_t Length() const { return end - begin; }
+  };
+
+  // Public methods
+public:
+  /**
+   * This method parses the given characters as a URI, recording
+   * where each element of the URI is located.
+   *
+   * @param[in] data
+   *     This points to the characters to parse.
+   *
+   * @param[in] length
+   *     This is the number of characters to parse.
+   *
+   * @return
+   *     An indication of whether or not the URI was
+   *     parsed successfully is returned.
+   */
+  bool ParseFromString(const char *data, size_t length);
+
+  /**
+   * This method parses the given string as a URI, recording
+   * where each element of the URI is located.
+   *
+   * @param[in] uriString
+   *     This is the string rendering of the URI to parse.
+   *     It must outlive the view.
+   *
+   * @return
+   *     An indication of whether or not the URI was
+   *     parsed successfully is returned.
+   */
+  bool ParseFromString(const std::string &uriString);
+
+  /**
+   * This overload is deleted so that a view can't be made of a
+   * temporary string, which would be destroyed before the view.
+   */
+  bool ParseFromString(std::string &&uriString) = delete;
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * has a scheme.
+   */
+  bool HasScheme() const { return hasScheme_; }
+
+  /**
+   * This method gets the "scheme" element of the URI.
+   *
+   * @retval
+   *     An empty view if the URI has no scheme.
+   */
+  StringView GetScheme() const { return View(scheme_); }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * has an authority.
+   */
+  bool HasAuthority() const { return hasAuthority_; }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * has user info.
+   */
+  bool HasUserInfo() const { return hasUserInfo_; }
+
+  /**
+   * This method gets the "user info" element of the URI.
+   *
+   * @retval
+   *     An empty view if the URI has no user info.
+   */
+  StringView GetUserInfo() const { return View(userInfo_); }
+
+  /**
+   * This method gets the "host" element of the URI.
+   *
+   * @retval
+   *     An empty view if the URI has no host.
+   */
+  StringView GetHost() const { return View(host_); }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * has a port number.
+   */
+  bool HasPort() const { return hasPort_; }
+
+  /**
+   * This method returns the port number element of the URI.
+   *
+   * @note
+   *     The returned port number is only valid if the
+   *     HasPort method returns true.
+   */
+  uint16_t GetPort() const { return port_; }
+
+  /**
+   * This method gets the whole "path" element of the URI,
+   * including the slashes which separate its segments.
+   *
+   * @retval
+   *     An empty view if the URI has an empty path.
+   */
+  StringView GetPath() const { return View(path_); }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * has a query.
+   */
+  bool HasQuery() const { return hasQuery_; }
+
+  /**
+   * This method gets the "query" element of the URI,
+   * without the leading question mark.
+   *
+   * @retval
+   *     An empty view if the URI has no query.
+   */
+  StringView GetQuery() const { return View(query_); }
+
+  /**
+   * This method gets the parameters of the "query" element of the
+   * URI, found as they're iterated (see QueryParameters).
+   */
+  QueryParameters GetQueryParameters() const { return QueryParameters(GetQuery()); }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * has a fragment.
+   */
+  bool HasFragment() const { return hasFragment_; }
+
+  /**
+   * This method gets the "fragment" element of the URI,
+   * without the leading number sign.
+   *
+   * @retval
+   *     An empty view if the URI has no fragment.
+   */
+  StringView GetFragment() const { return View(fragment_); }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * is a relative reference.
+   */
+  bool IsRelativeReference() const { return !hasScheme_; }
+
+  /**
+   * This method returns an indication of whether or not the URI
+   * contains a relative path.
+   */
+  bool ContainsRelativePath() const
+  {
+    return (path_.Length() == 0) || (data_[path_.begin] != '/');
+  }
+
+  /**
+   * These methods return where each element of the URI is located
+   * in the parsed characters.
+   */
+  Range GetSchemeRange() const { return scheme_; }
+  Range GetUserInfoRange() const { return userInfo_; }
+  Range GetHostRange() const { return host_; }
+  Range GetPathRange() const { return path_; }
+  Range GetQueryRange() const { return query_; }
+  Range GetFragmentRange() const { return fragment_; }
+
+  // Private methods
+private:
+  /**
+   * This method returns a view of the given span of the
+   * parsed characters.
+   */
+  StringView View(const Range &range) const
+  {
+    return StringView(data_ + range.begin, range.Length());
+  }
+
+  // Private properties
+private:
+  /**
+   * This points to the parsed characters.
+   */
+  const char *data_ = "";
+
+  /**
+   * These are the locations of the elements of the URI.
+   */
+  Range scheme_;
+  Range userInfo_;
+  Range host_;
+  Range path_;
+  Range query_;
+  Range fragment_;
+
+  /**
+   * This is the "port" element of the URI, if exists.
+   */
+  uint16_t port_ = 0;
+
+  /**
+   * These flags indicate which elements the URI has.
+   */
+  bool hasScheme_ = false;
+  bool hasAuthority_ = false;
+  bool hasUserInfo_ = false;
+  bool hasPort_ = false;
+  bool hasQuery_ = false;
+  bool hasFragment_ = false;
+};
+} // namespace Uri
+
+#endif /* URI_URI_VIEW_HPP */
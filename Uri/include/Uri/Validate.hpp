@@ -0,0 +1,140 @@
+#ifndef URI_VALIDATE_HPP
+#define URI_VALIDATE_HPP
+
+/**
+ * @file Validate.hpp
+ *
+ * This module declares the functions which check whether or not
+ * characters make up a valid URI-reference, as defined in RFC 3986
+ * (https://tools.ietf.org/html/rfc3986), without recording any of
+ * its elements.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Uri
+{
+/**
+ * These are the reasons why characters might not make up
+ * a valid URI.
+ */
+enum class ValidationError : uint8_t {
+    /**
+     * The characters make up a valid URI.
+     */
+    None,
+
+    /**
+     * A character was found which can't appear anywhere in a URI,
+     * such as a space, a control character, or a non-ASCII byte.
+     */
+    IllegalCharacter,
+
+    /**
+     * A character was found which can appear in a URI, but not where
+     * it was found, such as a colon in the first segment of a relative
+     * path, or a bracket outside of an IP-literal host.
+     */
+    MisplacedCharacter,
+
+    /**
+     * A "%" was not followed by two hexadecimal digits.
+     */
+    BadPercentEncoding,
+
+    /**
+     * The port was not made only of digits, or was too large
+     * to be a port number.
+     */
+    BadPort,
+
+    /**
+     * An IP-literal host, in brackets, had a character it can't,
+     * was not closed, or was followed by something other than
+     * a port or the end of the authority.
+     */
+    BadIpLiteral,
+};
+
+/**
+ * This is the outcome of checking whether or not characters
+ * make up a valid URI.
+ */
+struct ValidationResult {
+    /**
+     * This is the reason why the characters don't make up a valid
+     * URI, or None if they do.
+     */
+    ValidationError error = ValidationError::None;
+
+    /**
+     * This is where the character was found which made the characters
+     * not a valid URI, or the number of characters if they ended too
+     * soon.  It's zero if the characters make up a valid URI.
+     */
+    size_t errorOffset = 0;
+
+    /**
+     * This returns an indication of whether or not the characters
+     * make up a valid URI.
+     */
+    bool IsValid() const {
+        return (error == ValidationError::None);
+    }
+};
+
+/**
+ * This function returns a short description of the given reason
+ * why characters don't make up a valid URI, suitable for logging.
+ */
+const char* GetValidationErrorName(ValidationError error);
+
+/**
+ * This function checks whether or not the given characters make up
+ * a valid URI-reference, without recording any of its elements and
+ * without allocating any memory.
+ *
+ * @param[in] data
+ *     This points to the characters to check.
+ *
+ * @param[in] length
+ *     This is the number of characters to check.
+ *
+ * @return
+ *     Whether or not the characters make up a valid URI, and if not,
+ *     why not and where the problem is, is returned.
+ */
+ValidationResult Validate(const char* data, size_t length);
+
+/**
+ * This function checks whether or not the given string is a valid
+ * URI-reference, without recording any of its elements and without
+ * allocating any memory.
+ *
+ * @param[in] uriString
+ *     This is the string to check.
+ *
+ * @return
+ *     Whether or not the string is a valid URI, and if not,
+ *     why not and where the problem is, is returned.
+ */
+ValidationResult Validate(const std::string& uriString);
+
+/**
+ * This function returns an indication of whether or not the given
+ * characters make up a valid URI-reference.  It's the same as
+ * Validate, for when why not doesn't matter.
+ */
+bool IsValid(const char* data, size_t length);
+
+/**
+ * This function returns an indication of whether or not the given
+ * string is a valid URI-reference.  It's the same as Validate, for
+ * when why not doesn't matter.
+ */
+bool IsValid(const std::string& uriString);
+} // namespace Uri
+
+#endif /* URI_VALIDATE_HPP */
@@ -0,0 +1,253 @@
+/**
+ * @file BaseResolver.cpp
+ *
+ * This module contains the implementation of the
+ * Uri::BaseResolver class.
+ */
+
+#include <Uri/BaseResolver.hpp>
+
+#include "Parser.hpp"
+#include "Resolve.hpp"
+
+#include <string.h>
+
+namespace Uri
+{
+/**
+ * This contains the private properties of a BaseResolver instance.
+ */
+struct BaseResolver::Impl {
+    // Properties
+
+    /**
+     * This is the base URI.
+     */
+    std::string base;
+
+    /**
+     * This holds where the elements of the base URI are.
+     */
+    Elements elements;
+
+    /**
+     * This is what a target URI begins with when it's found by merging
+     * a relative path with the path of the base (RFC 3986 section
+     * 5.2.3): the scheme and authority of the base, followed by the
+     * path of the base up to and including its last slash.
+     */
+    std::string directoryPrefix;
+
+    /**
+     * This indicates whether or not the path part of the directory
+     * prefix has dot segments, in which case there are dot segments
+     * to remove from every merged path.
+     */
+    bool directoryHasDotSegments = false;
+
+    // Methods
+
+    /**
+     * This method takes the base URI apart, once, ready for
+     * resolving references against it.
+     */
+    void Prepare() {
+        const size_t pathBegin = elements.path.begin;
+        directoryPrefix.assign(base, 0, pathBegin);
+        if (elements.hasAuthority && (elements.path.Length() == 0)) {
+            directoryPrefix.push_back('/');
+        } else {
+            size_t directoryEnd = elements.path.end;
+            while (
+                (directoryEnd > pathBegin)
+                && (base[directoryEnd - 1] != '/')
+            ) {
+                --directoryEnd;
+            }
+            directoryPrefix.append(base, pathBegin, directoryEnd - pathBegin);
+        }
+        directoryHasDotSegments = HasDotSegments(
+            directoryPrefix.data() + pathBegin,
+            directoryPrefix.length() - pathBegin
+        );
+    }
+
+    /**
+     * This method returns the most characters which resolving
+     * a reference of the given length could produce.
+     */
+    size_t GetMaxTargetLength(size_t referenceLength) const {
+        return GetMaxResolvedLength(base.length(), referenceLength);
+    }
+
+    /**
+     * This method resolves a parsed reference.
+     *
+     * References which are just a relative path, with no dot segments
+     * in it or in the directory of the base, are by far the most
+     * common, and are put together by copying the directory prefix
+     * and the reference as they are, since joining the two at a slash
+     * can't make any new dot segments.  Everything else is resolved
+     * in full.
+     *
+     * @param[in] reference
+     *     This points to the characters of the reference.
+     *
+     * @param[in] length
+     *     This is the number of characters of the reference.
+     *
+     * @param[in] referenceElements
+     *     This holds where the elements of the reference are.
+     *
+     * @param[out] output
+     *     This is where to put the target URI, which must have room
+     *     for the number of characters returned by GetMaxTargetLength.
+     *
+     * @return
+     *     The number of characters of the target URI is returned.
+     */
+    size_t Resolve(
+        const char* reference,
+        size_t length,
+        const Elements& referenceElements,
+        char* output
+    ) const {
+        const auto& path = referenceElements.path;
+        if (
+            !referenceElements.hasScheme
+            && !referenceElements.hasAuthority
+            && (path.Length() > 0)
+            && (reference[path.begin] != '/')
+            && !directoryHasDotSegments
+            && !HasDotSegments(reference + path.begin, path.Length())
+        ) {
+            memcpy(output, directoryPrefix.data(), directoryPrefix.length());
+            memcpy(
+                output + directoryPrefix.length(),
+                reference + path.begin,
+                length - path.begin
+            );
+            return directoryPrefix.length() + (length - path.begin);
+        }
+        const auto target = ResolveReference(
+            base.data(),
+            elements,
+            reference,
+            referenceElements,
+            output
+        );
+        return target.fragment.end;
+    }
+};
+
+BaseResolver::~BaseResolver() = default;
+
+BaseResolver::BaseResolver(const BaseResolver &other)
+    : impl_(new Impl(other.impl()))
+{
+}
+
+BaseResolver::BaseResolver(BaseResolver &&other) noexcept = default;
+
+BaseResolver &BaseResolver::operator=(const BaseResolver &other)
+{
+    if (this != &other) {
+        impl() = other.impl();
+    }
+    return *this;
+}
+
+BaseResolver &BaseResolver::operator=(BaseResolver &&other) noexcept = default;
+
+BaseResolver::BaseResolver()
+    : impl_(new Impl)
+{
+}
+
+const BaseResolver::Impl &BaseResolver::impl() const
+{
+    if (impl_) {
+        return *impl_;
+    }
+    static const Impl empty;
+    return empty;
+}
+
+BaseResolver::Impl &BaseResolver::impl()
+{
+    // A resolver which was moved from has no private properties, until
+    // it's changed again, when it gets those of one with an empty base.
+    if (!impl_) {
+        impl_.reset(new Impl);
+    }
+    return *impl_;
+}
+
+bool BaseResolver::SetBase(const std::string &baseString)
+{
+    auto& resolverImpl = impl();
+    Parser parser;
+    if (!parser.Parse(baseString.data(), baseString.length())) {
+        resolverImpl = Impl();
+        return false;
+    }
+    resolverImpl.base = baseString;
+    resolverImpl.elements = parser.elements;
+    resolverImpl.Prepare();
+    return true;
+}
+
+StringView BaseResolver::GetBase() const
+{
+    const auto& base = impl().base;
+    return StringView(base.data(), base.length());
+}
+
+bool BaseResolver::Resolve(const char *data, size_t length, std::string &target) const
+{
+    Parser parser;
+    if (!parser.Parse(data, length)) {
+        return false;
+    }
+    const auto& resolverImpl = impl();
+    target.resize(resolverImpl.GetMaxTargetLength(length));
+    target.resize(resolverImpl.Resolve(data, length, parser.elements, &target[0]));
+    return true;
+}
+
+size_t BaseResolver::ResolveBatch(
+    const char *buffer,
+    const size_t *offsets,
+    size_t count,
+    ResolvedBatch &results
+) const
+{
+    const auto& resolverImpl = impl();
+    results.count = count;
+    results.offsets.resize(count + 1);
+    results.valid.assign((count + 63) / 64, 0);
+    results.arena.resize(
+        (count == 0) ? 0 : (
+            count * resolverImpl.GetMaxTargetLength(0)
+            + (offsets[count] - offsets[0])
+        )
+    );
+    char* const arena = &results.arena[0];
+    size_t written = 0;
+    size_t numValid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        results.offsets[i] = written;
+        const char* const reference = buffer + offsets[i];
+        const size_t length = offsets[i + 1] - offsets[i];
+        Parser parser;
+        if (parser.Parse(reference, length)) {
+            written += resolverImpl.Resolve(reference, length, parser.elements, arena + written);
+            results.valid[i / 64] |= ((uint64_t)1 << (i % 64));
+            ++numValid;
+        }
+    }
+    results.offsets[count] = written;
+    results.arena.resize(written);
+    return numValid;
+}
+} // namespace Uri
@@ -0,0 +1,134 @@
+#ifndef URI_BLOCK_FINDER_HPP
+#define URI_BLOCK_FINDER_HPP
+
+/**
+ * @file BlockFinder.hpp
+ *
+ * This module declares the Uri::BlockFinder class template.
+ */
+
+#include "DelimiterScan.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+/**
+ * This finds the characters of a span which a scanning kernel picks
+ * out, a block at a time, keeping the mask of the block last scanned
+ * so that each block is scanned only once however many characters
+ * are found in it.
+ *
+ * @tparam ScanFn
+ *     This is the type of the function which scans a whole block,
+ *     returning a mask with a bit set for each character found.
+ *
+ * @tparam PartialFn
+ *     This is the type of the function which scans fewer characters
+ *     than a whole block, at the end of the span.
+ *
+ * @tparam BlockSize
+ *     This is the number of characters scanned at once by ScanFn.
+ */
+template< typename ScanFn, typename PartialFn, size_t BlockSize >
+class BlockFinder {
+public:
+    /**
+     * This constructs a finder for the given span of characters.
+     */
+    BlockFinder(const char* data, size_t length, ScanFn scan, PartialFn partial)
+        : data_(data)
+        , length_(length)
+        , scan_(scan)
+        , partial_(partial)
+    {
+    }
+
+    /**
+     * This method finds the first character in the span, at or after
+     * the given position, which the scanning functions pick out.
+     *
+     * @param[in] position
+     *     This is the position where the search begins.
+     *
+     * @return
+     *     The position of the first character found is returned,
+     *     or the length of the span if there are none.
+     */
+    size_t Next(size_t position) {
+        return Find(
+            data_, length_, position, scan_, partial_,
+            blockBegin_, blockEnd_, mask_
+        );
+    }
+
+    /**
+     * This is the same as Next, for callers which keep the block
+     * last scanned themselves.
+     *
+     * @param[in,out] blockBegin
+     *     This is where the block last scanned begins.
+     *
+     * @param[in,out] blockEnd
+     *     This is where the block last scanned ends, or zero
+     *     if no block has been scanned yet.
+     *
+     * @param[in,out] mask
+     *     This has a bit set for each character found in the
+     *     block last scanned.
+     */
+    static size_t Find(
+        const char* data,
+        size_t length,
+        size_t position,
+        ScanFn scan,
+        PartialFn partial,
+        size_t& blockBegin,
+        size_t& blockEnd,
+        uint64_t& mask
+    ) {
+        for (;;) {
+            if (position >= blockEnd) {
+                if (position >= length) {
+                    return length;
+                }
+                blockBegin = position;
+                if (length - position >= BlockSize) {
+                    blockEnd = position + BlockSize;
+                    mask = scan(data + position);
+                } else {
+                    blockEnd = length;
+                    mask = partial(data + position, length - position);
+                }
+            }
+            const uint64_t remaining = (mask >> (position - blockBegin));
+            if (remaining != 0) {
+                return position + LowestSetBit(remaining);
+            }
+            position = blockEnd;
+        }
+    }
+
+private:
+    const char* data_;
+    size_t length_;
+    ScanFn scan_;
+    PartialFn partial_;
+    size_t blockBegin_ = 0;
+    size_t blockEnd_ = 0;
+    uint64_t mask_ = 0;
+};
+
+/**
+ * This is the type of the functions which scan a whole block.
+ */
+using BlockScanFn = uint64_t (*)(const char* data);
+
+/**
+ * This is the type of the functions which scan part of a block.
+ */
+using PartialBlockScanFn = uint64_t (*)(const char* data, size_t length);
+} // namespace Uri
+
+#endif /* URI_BLOCK_FINDER_HPP */
@@ -0,0 +1,440 @@
+/**
+ * @file Compare.cpp
+ *
+ * This module contains the implementation of the functions which
+ * compare two parsed URIs.
+ */
+
+#include "Compare.hpp"
+
+#include "Normalize.hpp"
+#include "Resolve.hpp"
+#include "SmallBuffer.hpp"
+
+#include <Uri/CharacterClasses.hpp>
+
+#include <string.h>
+
+namespace {
+/**
+ * This is the scratch space in which a path with dot segments
+ * is normalized before it's compared.
+ */
+typedef Uri::SmallBuffer< 256 > Scratch;
+
+/**
+ * This reads the characters of an element of a URI as they are once
+ * normalized, one at a time, without writing them anywhere.
+ */
+class NormalizedReader {
+public:
+    /**
+     * This is the value returned by Next once every
+     * character has been read.
+     */
+    static constexpr int END = -1;
+
+    /**
+     * This is added to the value of a percent-encoded octet which
+     * stays percent-encoded, so that it never reads the same as
+     * the character it encodes.
+     */
+    static constexpr int ENCODED = 0x100;
+
+    /**
+     * This sets up to read the given characters, making letters
+     * lowercase if asked to, as for a scheme or host.
+     */
+    NormalizedReader(const char* data, size_t length, bool lowercase)
+        : next_(data)
+        , end_(data + length)
+        , lowercase_(lowercase)
+    {
+    }
+
+    /**
+     * This method reads the next character, returning the character
+     * itself, ENCODED plus the value of a percent-encoded octet which
+     * isn't an unreserved character, or END if there are no more.
+     */
+    int Next() {
+        if (next_ == end_) {
+            return END;
+        }
+        char c = *next_++;
+        if (c == '%') {
+            const auto value = (Uri::HexValue(next_[0]) << 4) | Uri::HexValue(next_[1]);
+            next_ += 2;
+            c = (char)value;
+            if (
+                (value >= 0x80)
+                || !Uri::CharacterClasses::Is(c, Uri::CharacterClasses::UNRESERVED)
+            ) {
+                return ENCODED + (int)value;
+            }
+        }
+        return (int)(unsigned char)(lowercase_ ? Uri::ToLower(c) : c);
+    }
+
+private:
+    /**
+     * This points to the next character to read.
+     */
+    const char* next_;
+
+    /**
+     * This points just past the last character to read.
+     */
+    const char* const end_;
+
+    /**
+     * This indicates whether or not to make letters lowercase.
+     */
+    const bool lowercase_;
+};
+
+/**
+ * This function compares two runs of characters as they are, the way
+ * strings are compared.
+ */
+int CompareText(const char* data, size_t length, const char* otherData, size_t otherLength) {
+    const int result = memcmp(data, otherData, (length < otherLength) ? length : otherLength);
+    if (result != 0) {
+        return result;
+    }
+    return (length < otherLength) ? -1 : ((length > otherLength) ? 1 : 0);
+}
+
+/**
+ * This function compares the same element of two URIs as it's
+ * written.
+ */
+int CompareRanges(
+    const char* data,
+    const Uri::UriView::Range& range,
+    const char* otherData,
+    const Uri::UriView::Range& otherRange
+) {
+    return CompareText(
+        data + range.begin,
+        range.Length(),
+        otherData + otherRange.begin,
+        otherRange.Length()
+    );
+}
+
+/**
+ * This function compares whether or not two URIs have an element,
+ * an element a URI doesn't have coming before one it does have.
+ */
+int ComparePresence(bool has, bool otherHas) {
+    return (int)has - (int)otherHas;
+}
+
+/**
+ * This function returns an indication of whether or not the given
+ * URI has a port which isn't empty.
+ */
+bool HasNonEmptyPort(const Uri::Elements& elements) {
+    return (
+        elements.hasPort
+        && (elements.path.begin - elements.host.end > 1)
+    );
+}
+
+/**
+ * This function determines whether or not two runs of characters are
+ * the same once normalized, stopping at the first difference.
+ */
+bool SameNormalized(
+    const char* data,
+    size_t length,
+    const char* otherData,
+    size_t otherLength,
+    bool lowercase
+) {
+    // Characters written exactly the same way are the same however
+    // they're normalized, so only what follows the longest run written
+    // the same way, backed up to the beginning of any percent-encoded
+    // octet it ends in, is read one character at a time.
+    if ((length == otherLength) && (memcmp(data, otherData, length) == 0)) {
+        return true;
+    }
+    const size_t shorterLength = (length < otherLength) ? length : otherLength;
+    size_t same = 0;
+    while ((same < shorterLength) && (data[same] == otherData[same])) {
+        ++same;
+    }
+    if ((same >= 1) && (data[same - 1] == '%')) {
+        same -= 1;
+    } else if ((same >= 2) && (data[same - 2] == '%')) {
+        same -= 2;
+    }
+    NormalizedReader reader(data + same, length - same, lowercase);
+    NormalizedReader otherReader(otherData + same, otherLength - same, lowercase);
+    for (;;) {
+        const int c = reader.Next();
+        if (c != otherReader.Next()) {
+            return false;
+        }
+        if (c == NormalizedReader::END) {
+            return true;
+        }
+    }
+}
+
+/**
+ * This function determines whether or not the same element of two URIs
+ * is the same once normalized.
+ */
+bool SameNormalizedRanges(
+    const char* data,
+    const Uri::UriView::Range& range,
+    const char* otherData,
+    const Uri::UriView::Range& otherRange,
+    bool lowercase
+) {
+    return SameNormalized(
+        data + range.begin,
+        range.Length(),
+        otherData + otherRange.begin,
+        otherRange.Length(),
+        lowercase
+    );
+}
+
+/**
+ * This function returns an indication of whether or not the given
+ * path may have dot segments once its percent-encoded unreserved
+ * characters are decoded, which is when it has any already, or has
+ * a percent-encoded ".".
+ */
+bool MayHaveDotSegments(const char* path, size_t length) {
+    if (Uri::HasDotSegments(path, length)) {
+        return true;
+    }
+    const char* const end = path + length;
+    const char* percent = path;
+    while ((percent = (const char*)memchr(percent, '%', (size_t)(end - percent))) != nullptr) {
+        if ((percent[1] == '2') && (Uri::ToLower(percent[2]) == 'e')) {
+            return true;
+        }
+        percent += 3;
+    }
+    return false;
+}
+
+/**
+ * This function finds the characters of the path of a URI, as far as
+ * normalizing them needs more than reading them one at a time: dot
+ * segments are removed, into the given scratch space, a path without
+ * an authority which is left beginning with "//" is given "/." in
+ * front, and an empty path of a scheme known to have a default port
+ * is made "/".
+ *
+ * @param[in] data
+ *     This points to the characters of the URI.
+ *
+ * @param[in] elements
+ *     This holds where the elements of the URI are.
+ *
+ * @param[in] knownScheme
+ *     This indicates whether or not the scheme of the URI
+ *     is known to have a default port.
+ *
+ * @param[in,out] length
+ *     This is where to put the number of characters of the path.
+ *
+ * @param[in] scratch
+ *     This is where to remove dot segments from the path, if needed.
+ *
+ * @return
+ *     The characters of the path are returned.
+ */
+const char* PreparePath(
+    const char* data,
+    const Uri::Elements& elements,
+    bool knownScheme,
+    size_t& length,
+    Scratch& scratch
+) {
+    const char* path = data + elements.path.begin;
+    length = elements.path.Length();
+    if (elements.hasScheme && MayHaveDotSegments(path, length)) {
+        scratch.resize(length);
+        length = Uri::NormalizePercentEncoding(path, length, scratch.data());
+        length = Uri::RemoveDotSegments(scratch.data(), length, scratch.data());
+        if (!elements.hasAuthority) {
+            length = Uri::KeepPathFromLookingLikeAuthority(scratch.data(), length);
+        }
+        path = scratch.data();
+    }
+    if ((length == 0) && elements.hasAuthority && knownScheme) {
+        length = 1;
+        return "/";
+    }
+    return path;
+}
+}
+
+namespace Uri
+{
+int CompareElements(
+    const char* data,
+    const Elements& elements,
+    const char* otherData,
+    const Elements& otherElements
+) {
+    int result = ComparePresence(elements.hasScheme, otherElements.hasScheme);
+    if ((result == 0) && elements.hasScheme) {
+        result = CompareRanges(data, elements.scheme, otherData, otherElements.scheme);
+    }
+    if (result == 0) {
+        result = ComparePresence(elements.hasAuthority, otherElements.hasAuthority);
+    }
+    if ((result == 0) && elements.hasAuthority) {
+        result = ComparePresence(elements.hasUserInfo, otherElements.hasUserInfo);
+        if ((result == 0) && elements.hasUserInfo) {
+            result = CompareRanges(data, elements.userInfo, otherData, otherElements.userInfo);
+        }
+        if (result == 0) {
+            result = CompareRanges(data, elements.host, otherData, otherElements.host);
+        }
+        if (result == 0) {
+            const bool hasPort = HasNonEmptyPort(elements);
+            result = ComparePresence(hasPort, HasNonEmptyPort(otherElements));
+            if ((result == 0) && hasPort) {
+                result = (int)elements.port - (int)otherElements.port;
+            }
+        }
+    }
+    if (result == 0) {
+        result = CompareRanges(data, elements.path, otherData, otherElements.path);
+    }
+    if (result == 0) {
+        result = ComparePresence(elements.hasQuery, otherElements.hasQuery);
+    }
+    if ((result == 0) && elements.hasQuery) {
+        result = CompareRanges(data, elements.query, otherData, otherElements.query);
+    }
+    if (result == 0) {
+        result = ComparePresence(elements.hasFragment, otherElements.hasFragment);
+    }
+    if ((result == 0) && elements.hasFragment) {
+        result = CompareRanges(data, elements.fragment, otherData, otherElements.fragment);
+    }
+    return result;
+}
+
+bool AreEquivalent(
+    const char* data,
+    const Elements& elements,
+    const char* otherData,
+    const Elements& otherElements
+) {
+    if (
+        (elements.hasScheme != otherElements.hasScheme)
+        || (elements.hasAuthority != otherElements.hasAuthority)
+        || (elements.hasQuery != otherElements.hasQuery)
+        || (elements.hasFragment != otherElements.hasFragment)
+    ) {
+        return false;
+    }
+
+    // The scheme is needed to know its default port, and a scheme
+    // too long to fit here isn't one known to have one.
+    bool knownScheme = false;
+    uint16_t defaultPort = 0;
+    if (elements.hasScheme) {
+        if (
+            !SameNormalizedRanges(
+                data,
+                elements.scheme,
+                otherData,
+                otherElements.scheme,
+                true
+            )
+        ) {
+            return false;
+        }
+        char scheme[16];
+        if (elements.scheme.Length() <= sizeof(scheme)) {
+            const size_t schemeLength = NormalizeLowercase(
+                data + elements.scheme.begin,
+                elements.scheme.Length(),
+                scheme
+            );
+            knownScheme = GetDefaultPort(scheme, schemeLength, defaultPort);
+        }
+    }
+    if (elements.hasAuthority) {
+        if (
+            (elements.hasUserInfo != otherElements.hasUserInfo)
+            || (
+                elements.hasUserInfo
+                && !SameNormalizedRanges(
+                    data,
+                    elements.userInfo,
+                    otherData,
+                    otherElements.userInfo,
+                    false
+                )
+            )
+            || !SameNormalizedRanges(
+                data,
+                elements.host,
+                otherData,
+                otherElements.host,
+                true
+            )
+        ) {
+            return false;
+        }
+        const bool hasPort = (
+            HasNonEmptyPort(elements)
+            && (!knownScheme || (elements.port != defaultPort))
+        );
+        const bool otherHasPort = (
+            HasNonEmptyPort(otherElements)
+            && (!knownScheme || (otherElements.port != defaultPort))
+        );
+        if (
+            (hasPort != otherHasPort)
+            || (hasPort && (elements.port != otherElements.port))
+        ) {
+            return false;
+        }
+    }
+    // Paths written exactly the same way are the same once normalized,
+    // without looking for dot segments in them.
+    if (
+        CompareRanges(data, elements.path, otherData, otherElements.path) != 0
+    ) {
+        Scratch scratch;
+        Scratch otherScratch;
+        size_t pathLength;
+        size_t otherPathLength;
+        const char* const path = PreparePath(data, elements, knownScheme, pathLength, scratch);
+        const char* const otherPath = PreparePath(
+            otherData,
+            otherElements,
+            knownScheme,
+            otherPathLength,
+            otherScratch
+        );
+        if (!SameNormalized(path, pathLength, otherPath, otherPathLength, false)) {
+            return false;
+        }
+    }
+    return (
+        (
+            !elements.hasQuery
+            || SameNormalizedRanges(data, elements.query, otherData, otherElements.query, false)
+        )
+        && (
+            !elements.hasFragment
+            || SameNormalizedRanges(data, elements.fragment, otherData, otherElements.fragment, false)
+        )
+    );
+}
+} // namespace Uri
@@ -0,0 +1,84 @@
+#ifndef URI_COMPARE_HPP
+#define URI_COMPARE_HPP
+
+/**
+ * @file Compare.hpp
+ *
+ * This module declares the functions which compare two parsed URIs,
+ * element by element, straight out of their characters.
+ */
+
+#include "Parser.hpp"
+
+namespace Uri
+{
+/**
+ * This function compares two parsed URIs, element by element, in the
+ * order scheme, user info, host, port, path, query, and fragment,
+ * stopping at the first element which differs.
+ *
+ * An element a URI doesn't have comes before any element it does
+ * have, even an empty one.  A port is compared by its value, and an
+ * empty port is the same as none at all, as when the URI is rendered
+ * as a string.
+ *
+ * @param[in] data
+ *     This points to the characters of the first URI.
+ *
+ * @param[in] elements
+ *     This holds where the elements of the first URI are.
+ *
+ * @param[in] otherData
+ *     This points to the characters of the second URI.
+ *
+ * @param[in] otherElements
+ *     This holds where the elements of the second URI are.
+ *
+ * @return
+ *     A negative number, zero, or a positive number is returned,
+ *     if the first URI comes before, is the same as, or comes after
+ *     the second one.
+ */
+int CompareElements(
+    const char* data,
+    const Elements& elements,
+    const char* otherData,
+    const Elements& otherElements
+);
+
+/**
+ * This function determines whether or not two parsed URIs are the
+ * same once normalized, as by NormalizeElements, element by element,
+ * without normalizing either of them first.
+ *
+ * The elements are compared as they're read, decoding percent-encoded
+ * unreserved characters, and ignoring the case of the scheme, the host,
+ * and the hexadecimal digits of percent-encoded octets, stopping at
+ * the first character which differs.  Only a path with dot segments
+ * is normalized before it's compared, in a small buffer on the stack.
+ *
+ * @param[in] data
+ *     This points to the characters of the first URI.
+ *
+ * @param[in] elements
+ *     This holds where the elements of the first URI are.
+ *
+ * @param[in] otherData
+ *     This points to the characters of the second URI.
+ *
+ * @param[in] otherElements
+ *     This holds where the elements of the second URI are.
+ *
+ * @return
+ *     An indication of whether or not the URIs are equivalent
+ *     is returned.
+ */
+bool AreEquivalent(
+    const char* data,
+    const Elements& elements,
+    const char* otherData,
+    const Elements& otherElements
+);
+} // namespace Uri
+
+#endif /* URI_COMPARE_HPP */
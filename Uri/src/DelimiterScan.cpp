@@ -0,0 +1,190 @@
+/**
+ * @file DelimiterScan.cpp
+ *
+ * This module contains the implementation of the functions which find
+ * the delimiters of a URI many characters at a time.
+ */
+
+#include "DelimiterScan.hpp"
+
+#include <Uri/CharacterClasses.hpp>
+
+#if defined(URI_X86)
+#include <immintrin.h>
+#endif
+
+namespace {
+/**
+ * This function classifies the given characters one at a time.
+ *
+ * @param[in] data
+ *     This points to the characters to classify.
+ *
+ * @param[in] length
+ *     This is the number of characters to classify.
+ *
+ * @return
+ *     A mask with a bit set for each character which is not
+ *     ordinary is returned.
+ */
+uint64_t ScanCharacters(const char* data, size_t length) {
+    constexpr uint16_t ordinary = (
+        Uri::CharacterClasses::UNRESERVED
+        | Uri::CharacterClasses::SUB_DELIMS
+    );
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (!Uri::CharacterClasses::Is(data[i], ordinary)) {
+            mask |= ((uint64_t)1 << i);
+        }
+    }
+    return mask;
+}
+
+#if defined(URI_X86)
+/**
+ * This function determines which of the given characters, taken as
+ * signed bytes, are in the given range.  Characters of 0x80 and above
+ * are negative, and so are never in a range of ASCII characters.
+ */
+URI_TARGET("sse2")
+__m128i InRange(__m128i characters, char low, char high) {
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(characters, _mm_set1_epi8((char)(low - 1))),
+        _mm_cmplt_epi8(characters, _mm_set1_epi8((char)(high + 1)))
+    );
+}
+
+/**
+ * This function determines which of the given characters are
+ * equal to the given character.
+ */
+URI_TARGET("sse2")
+__m128i Equal(__m128i characters, char c) {
+    return _mm_cmpeq_epi8(characters, _mm_set1_epi8(c));
+}
+
+/**
+ * This function classifies 16 characters at once with a handful of
+ * range and equality comparisons.  Letters are folded to lower case
+ * first, so one range covers them all.
+ */
+URI_TARGET("sse2")
+uint32_t ScanDelimiters16(const char* data) {
+    const __m128i characters = _mm_loadu_si128((const __m128i*)data);
+    const __m128i folded = _mm_or_si128(characters, _mm_set1_epi8(0x20));
+    const __m128i ordinary = _mm_or_si128(
+        _mm_or_si128(
+            _mm_or_si128(
+                InRange(folded, 'a', 'z'),
+                InRange(characters, '0', '9')
+            ),
+            _mm_or_si128(
+                InRange(characters, '&', '.'),
+                _mm_or_si128(Equal(characters, '!'), Equal(characters, '$'))
+            )
+        ),
+        _mm_or_si128(
+            _mm_or_si128(Equal(characters, ';'), Equal(characters, '=')),
+            _mm_or_si128(Equal(characters, '_'), Equal(characters, '~'))
+        )
+    );
+    return (uint32_t)(~_mm_movemask_epi8(ordinary) & 0xFFFF);
+}
+
+/**
+ * This is a table, indexed by the low nibble of a character, of bits
+ * which tell for which high nibbles the character is ordinary.  Bit N
+ * is set if the character with high nibble N is ordinary.  Characters
+ * with a high nibble of 8 or more are never ordinary.
+ */
+#define URI_LOW_NIBBLE_BITS \
+    (char)0xA8, (char)0xFC, (char)0xF8, (char)0xF8, \
+    (char)0xFC, (char)0xF8, (char)0xFC, (char)0xFC, \
+    (char)0xFC, (char)0xFC, (char)0xF4, (char)0x5C, \
+    (char)0x54, (char)0x5C, (char)0xD4, (char)0x70
+
+/**
+ * This function classifies 32 characters at once, looking up the
+ * nibbles of each character in URI_LOW_NIBBLE_BITS and
+ * URI_HIGH_NIBBLE_BIT.
+ */
+URI_TARGET("avx2")
+uint32_t ScanDelimiters32(const char* data) {
+    const __m256i lowNibbleBits = _mm256_setr_epi8(
+        URI_LOW_NIBBLE_BITS, URI_LOW_NIBBLE_BITS
+    );
+    const __m256i highNibbleBit = _mm256_setr_epi8(
+        URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT
+    );
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i characters = _mm256_loadu_si256((const __m256i*)data);
+    const __m256i low = _mm256_and_si256(characters, nibble);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(characters, 4), nibble);
+    const __m256i bits = _mm256_and_si256(
+        _mm256_shuffle_epi8(lowNibbleBits, low),
+        _mm256_shuffle_epi8(highNibbleBit, high)
+    );
+    const __m256i special = _mm256_cmpeq_epi8(bits, _mm256_setzero_si256());
+    return (uint32_t)_mm256_movemask_epi8(special);
+}
+#endif
+}
+
+namespace Uri
+{
+uint64_t ScanDelimitersScalar(const char* data) {
+    return ScanCharacters(data, DELIMITER_SCAN_BLOCK_SIZE);
+}
+
+#if defined(URI_X86)
+URI_TARGET("sse2")
+uint64_t ScanDelimitersSse2(const char* data) {
+    return (
+        (uint64_t)ScanDelimiters16(data)
+        | ((uint64_t)ScanDelimiters16(data + 16) << 16)
+        | ((uint64_t)ScanDelimiters16(data + 32) << 32)
+        | ((uint64_t)ScanDelimiters16(data + 48) << 48)
+    );
+}
+
+URI_TARGET("avx2")
+uint64_t ScanDelimitersAvx2(const char* data) {
+    return (
+        (uint64_t)ScanDelimiters32(data)
+        | ((uint64_t)ScanDelimiters32(data + 32) << 32)
+    );
+}
+
+/**
+ * These are URI_LOW_NIBBLE_BITS and URI_HIGH_NIBBLE_BIT repeated for
+ * each 16-character lane of a 512-bit vector, so that they can be
+ * loaded straight into one rather than broadcast into it.
+ */
+alignas(64) constexpr char LOW_NIBBLE_BITS_LANES[64] = {
+    URI_LOW_NIBBLE_BITS, URI_LOW_NIBBLE_BITS, URI_LOW_NIBBLE_BITS, URI_LOW_NIBBLE_BITS
+};
+alignas(64) constexpr char HIGH_NIBBLE_BIT_LANES[64] = {
+    URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT
+};
+
+URI_TARGET("avx512f,avx512bw")
+uint64_t ScanDelimitersAvx512(const char* data) {
+    const __m512i lowNibbleBits = _mm512_load_si512((const void*)LOW_NIBBLE_BITS_LANES);
+    const __m512i highNibbleBit = _mm512_load_si512((const void*)HIGH_NIBBLE_BIT_LANES);
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    const __m512i characters = _mm512_loadu_si512((const void*)data);
+    const __m512i low = _mm512_and_si512(characters, nibble);
+    const __m512i high = _mm512_and_si512(_mm512_srli_epi16(characters, 4), nibble);
+    const __m512i bits = _mm512_and_si512(
+        _mm512_shuffle_epi8(lowNibbleBits, low),
+        _mm512_shuffle_epi8(highNibbleBit, high)
+    );
+    return (uint64_t)_mm512_testn_epi8_mask(bits, bits);
+}
+#endif
+
+uint64_t ScanDelimitersPartial(const char* data, size_t length) {
+    return ScanCharacters(data, length);
+}
+} // namespace Uri
@@ -0,0 +1,123 @@
+#ifndef URI_DELIMITER_SCAN_HPP
+#define URI_DELIMITER_SCAN_HPP
+
+/**
+ * @file DelimiterScan.hpp
+ *
+ * This module declares the functions which find the delimiters
+ * of a URI many characters at a time.
+ */
+
+#include "Kernels.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * This is a table, indexed by the high nibble of a character, of the
+ * bit for that high nibble in a table indexed by the low nibble of a
+ * character, such as URI_LOW_NIBBLE_BITS.  Vectorized kernels use the
+ * two tables to look up whether a character is in a set with two
+ * byte shuffles, for any set of characters below 0x80.
+ */
+#define URI_HIGH_NIBBLE_BIT \
+    1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0
+
+namespace Uri
+{
+/**
+ * This is the number of characters classified at once
+ * by the ScanDelimiters function.
+ */
+constexpr size_t DELIMITER_SCAN_BLOCK_SIZE = 64;
+
+/**
+ * These functions classify a block of characters, finding those which
+ * may end a run of ordinary characters.  A character is ordinary if it
+ * is unreserved or a sub-delim (RFC 3986 section 2), since such
+ * characters mean the same thing everywhere in a URI outside the
+ * scheme and port.  Everything else, which is the gen-delims
+ * ":/?#[]@", the "%" which begins a percent-encoded octet, and any
+ * character not allowed in a URI at all, is not ordinary.
+ *
+ * There is one function for each kernel set; use ScanDelimiters
+ * to call the one currently in use.
+ *
+ * @param[in] data
+ *     This points to the block of DELIMITER_SCAN_BLOCK_SIZE
+ *     characters to classify.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each character
+ *     of the block which is not ordinary, with the least significant
+ *     bit corresponding to the first character.
+ */
+uint64_t ScanDelimitersScalar(const char* data);
+#if defined(URI_X86)
+uint64_t ScanDelimitersSse2(const char* data);
+uint64_t ScanDelimitersAvx2(const char* data);
+uint64_t ScanDelimitersAvx512(const char* data);
+#endif
+
+/**
+ * This function classifies a block of characters with the
+ * kernel currently in use (see ScanDelimitersScalar).
+ */
+inline uint64_t ScanDelimiters(const char* data) {
+    return GetKernels().scanDelimiters(data);
+}
+
+/**
+ * This function is the same as ScanDelimiters, except that it
+ * classifies only the given number of characters, which may be
+ * fewer than a whole block.
+ *
+ * @param[in] data
+ *     This points to the characters to classify.
+ *
+ * @param[in] length
+ *     This is the number of characters to classify, which must
+ *     not exceed DELIMITER_SCAN_BLOCK_SIZE.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each character
+ *     which is not ordinary.  Bits past the given number of
+ *     characters are clear.
+ */
+uint64_t ScanDelimitersPartial(const char* data, size_t length);
+
+/**
+ * This function returns the position of the least significant
+ * set bit of the given mask, which must not be zero.
+ */
+inline unsigned int LowestSetBit(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    (void)_BitScanForward64(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctzll(mask);
+#endif
+}
+
+/**
+ * This function returns the number of set bits of the given mask.
+ */
+inline unsigned int CountSetBits(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned int count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+#else
+    return (unsigned int)__builtin_popcountll(mask);
+#endif
+}
+} // namespace Uri
+
+#endif /* URI_DELIMITER_SCAN_HPP */
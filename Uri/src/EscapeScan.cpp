@@ -0,0 +1,115 @@
+/**
+ * @file EscapeScan.cpp
+ *
+ * This module contains the implementation of the functions which find
+ * the characters which need to be percent-encoded many characters
+ * at a time.
+ */
+
+#include "EscapeScan.hpp"
+
+#include <string.h>
+
+#if defined(URI_X86)
+#include <immintrin.h>
+#endif
+
+namespace {
+/**
+ * This function classifies the given characters one at a time.
+ */
+uint64_t ScanCharacters(
+    const char* data,
+    size_t length,
+    const uint8_t* lowNibbleBits
+) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const auto c = (unsigned char)data[i];
+        if ((c >= 0x80) || (((lowNibbleBits[c & 0x0F] >> (c >> 4)) & 1) == 0)) {
+            mask |= ((uint64_t)1 << i);
+        }
+    }
+    return mask;
+}
+
+#if defined(URI_X86)
+/**
+ * This function classifies 32 characters at once, looking up the
+ * nibbles of each character in the given table and in
+ * URI_HIGH_NIBBLE_BIT.
+ */
+URI_TARGET("avx2")
+uint32_t ScanEscapes32(const char* data, __m256i lowNibbleBits) {
+    const __m256i highNibbleBit = _mm256_setr_epi8(
+        URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT
+    );
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i characters = _mm256_loadu_si256((const __m256i*)data);
+    const __m256i low = _mm256_and_si256(characters, nibble);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(characters, 4), nibble);
+    const __m256i bits = _mm256_and_si256(
+        _mm256_shuffle_epi8(lowNibbleBits, low),
+        _mm256_shuffle_epi8(highNibbleBit, high)
+    );
+    const __m256i escaped = _mm256_cmpeq_epi8(bits, _mm256_setzero_si256());
+    return (uint32_t)_mm256_movemask_epi8(escaped);
+}
+#endif
+}
+
+namespace Uri
+{
+uint64_t ScanEscapesScalar(const char* data, const uint8_t* lowNibbleBits) {
+    return ScanCharacters(data, ESCAPE_SCAN_BLOCK_SIZE, lowNibbleBits);
+}
+
+#if defined(URI_X86)
+URI_TARGET("avx2")
+uint64_t ScanEscapesAvx2(const char* data, const uint8_t* lowNibbleBits) {
+    const __m256i table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)lowNibbleBits)
+    );
+    return (
+        (uint64_t)ScanEscapes32(data, table)
+        | ((uint64_t)ScanEscapes32(data + 32, table) << 32)
+    );
+}
+
+/**
+ * This is URI_HIGH_NIBBLE_BIT repeated for each 16-character lane of
+ * a 512-bit vector, so that it can be loaded straight into one rather
+ * than broadcast into it.
+ */
+alignas(64) constexpr char HIGH_NIBBLE_BIT_LANES[64] = {
+    URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT, URI_HIGH_NIBBLE_BIT
+};
+
+URI_TARGET("avx512f,avx512bw")
+uint64_t ScanEscapesAvx512(const char* data, const uint8_t* lowNibbleBits) {
+    int32_t lowNibbleWords[4];
+    memcpy(lowNibbleWords, lowNibbleBits, sizeof(lowNibbleWords));
+    const __m512i table = _mm512_set4_epi32(
+        lowNibbleWords[3], lowNibbleWords[2], lowNibbleWords[1], lowNibbleWords[0]
+    );
+    const __m512i highNibbleBit = _mm512_load_si512((const void*)HIGH_NIBBLE_BIT_LANES);
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    const __m512i characters = _mm512_loadu_si512((const void*)data);
+    const __m512i low = _mm512_and_si512(characters, nibble);
+    const __m512i high = _mm512_and_si512(_mm512_srli_epi16(characters, 4), nibble);
+    const __m512i bits = _mm512_and_si512(
+        _mm512_shuffle_epi8(table, low),
+        _mm512_shuffle_epi8(highNibbleBit, high)
+    );
+    return (uint64_t)_mm512_testn_epi8_mask(bits, bits);
+}
+#endif
+
+uint64_t ScanEscapesPartial(
+    const char* data,
+    size_t length,
+    const uint8_t* lowNibbleBits
+) {
+    return ScanCharacters(data, length, lowNibbleBits);
+}
+} // namespace Uri
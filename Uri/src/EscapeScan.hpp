@@ -0,0 +1,91 @@
+#ifndef URI_ESCAPE_SCAN_HPP
+#define URI_ESCAPE_SCAN_HPP
+
+/**
+ * @file EscapeScan.hpp
+ *
+ * This module declares the functions which find the characters which
+ * need to be percent-encoded many characters at a time.
+ */
+
+#include "DelimiterScan.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+/**
+ * This is the number of characters classified at once
+ * by the ScanEscapes function.
+ */
+constexpr size_t ESCAPE_SCAN_BLOCK_SIZE = 64;
+
+/**
+ * These functions find the characters in a block of characters which
+ * are not in a set of characters allowed to appear as they are.
+ *
+ * The set is given as a table indexed by the low nibble of a
+ * character, where bit N of an entry is set if the character with
+ * that low nibble and a high nibble of N is in the set.  Characters
+ * of 0x80 and above are never in the set.
+ *
+ * There is one function for each kernel set; use ScanEscapes
+ * to call the one currently in use.
+ *
+ * @param[in] data
+ *     This points to the block of ESCAPE_SCAN_BLOCK_SIZE
+ *     characters to classify.
+ *
+ * @param[in] lowNibbleBits
+ *     This points to the 16 entries of the table of the set of
+ *     characters allowed to appear as they are.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each character
+ *     of the block which is not in the set, with the least
+ *     significant bit corresponding to the first character.
+ */
+uint64_t ScanEscapesScalar(const char* data, const uint8_t* lowNibbleBits);
+#if defined(URI_X86)
+uint64_t ScanEscapesAvx2(const char* data, const uint8_t* lowNibbleBits);
+uint64_t ScanEscapesAvx512(const char* data, const uint8_t* lowNibbleBits);
+#endif
+
+/**
+ * This function classifies a block of characters with the
+ * kernel currently in use (see ScanEscapesScalar).
+ */
+inline uint64_t ScanEscapes(const char* data, const uint8_t* lowNibbleBits) {
+    return GetKernels().scanEscapes(data, lowNibbleBits);
+}
+
+/**
+ * This function is the same as ScanEscapes, except that it
+ * classifies only the given number of characters, which may be
+ * fewer than a whole block.
+ *
+ * @param[in] data
+ *     This points to the characters to classify.
+ *
+ * @param[in] length
+ *     This is the number of characters to classify, which must
+ *     not exceed ESCAPE_SCAN_BLOCK_SIZE.
+ *
+ * @param[in] lowNibbleBits
+ *     This points to the 16 entries of the table of the set of
+ *     characters allowed to appear as they are.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each character
+ *     which is not in the set.  Bits past the given number of
+ *     characters are clear.
+ */
+uint64_t ScanEscapesPartial(
+    const char* data,
+    size_t length,
+    const uint8_t* lowNibbleBits
+);
+} // namespace Uri
+
+#endif /* URI_ESCAPE_SCAN_HPP */
@@ -0,0 +1,312 @@
+/**
+ * @file Fingerprint.cpp
+ *
+ * This module contains the implementation of the functions which
+ * compute a fingerprint of selected elements of a URI.
+ */
+
+#include <Uri/Fingerprint.hpp>
+
+#include <Uri/StringView.hpp>
+
+#include "FingerprintElements.hpp"
+#include "Hasher.hpp"
+#include "Normalize.hpp"
+#include "Resolve.hpp"
+#include "SmallBuffer.hpp"
+
+#include <string.h>
+
+namespace {
+/**
+ * These tag each element as it goes into the hash, so that the same
+ * characters in different elements make different fingerprints.
+ */
+enum Tag : uint64_t {
+    SchemeTag = 1,
+    UserInfoTag,
+    HostTag,
+    PortTag,
+    PathTag,
+    QueryTag,
+    FragmentTag,
+};
+
+/**
+ * These are the keys of the well-known query parameters which
+ * track where a visitor came from, other than those beginning
+ * with "utm_", which all do.
+ */
+const Uri::StringView trackingParameters[] = {
+    Uri::StringView("gclid", 5),
+    Uri::StringView("dclid", 5),
+    Uri::StringView("fbclid", 6),
+    Uri::StringView("msclkid", 7),
+    Uri::StringView("yclid", 5),
+    Uri::StringView("mc_cid", 6),
+    Uri::StringView("mc_eid", 6),
+    Uri::StringView("_ga", 3),
+    Uri::StringView("_gl", 3),
+};
+
+/**
+ * This is the scratch space in which the few elements which
+ * need normalizing are normalized before they're hashed.
+ */
+typedef Uri::SmallBuffer< 256 > Scratch;
+
+/**
+ * This function adds an element of the URI to the hash.
+ */
+void AbsorbElement(Uri::Hasher& hasher, Tag tag, const char* data, size_t length) {
+    hasher.Absorb((uint64_t)tag | ((uint64_t)length << 8));
+    hasher.Absorb(data, length);
+}
+
+/**
+ * This function determines whether or not the given query parameter
+ * is to be left out of the fingerprint.
+ */
+bool IsExcluded(
+    const char* parameter,
+    size_t length,
+    const Uri::FingerprintOptions& options
+) {
+    const auto equals = (const char*)memchr(parameter, '=', length);
+    const size_t keyLength = (equals == nullptr) ? length : (size_t)(equals - parameter);
+    if (options.excludeTrackingParameters) {
+        if ((keyLength > 4) && (memcmp(parameter, "utm_", 4) == 0)) {
+            return true;
+        }
+        for (const auto& trackingParameter: trackingParameters) {
+            if (
+                (trackingParameter.size() == keyLength)
+                && (memcmp(trackingParameter.data(), parameter, keyLength) == 0)
+            ) {
+                return true;
+            }
+        }
+    }
+    for (const auto& excludedParameter: options.excludedParameters) {
+        if (
+            (excludedParameter.length() == keyLength)
+            && (memcmp(excludedParameter.data(), parameter, keyLength) == 0)
+        ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * This function normalizes the percent-encoded octets of the given
+ * characters into the given scratch space, if they have any.
+ *
+ * @return
+ *     The characters, normalized, are returned, either where they
+ *     were, or in the scratch space.
+ */
+const char* NormalizeIfNeeded(const char* data, size_t& length, Scratch& scratch) {
+    if (memchr(data, '%', length) == nullptr) {
+        return data;
+    }
+    scratch.resize(length);
+    length = Uri::NormalizePercentEncoding(data, length, scratch.data());
+    return scratch.data();
+}
+
+/**
+ * This function adds the query of the URI to the hash, as a whole,
+ * or as a set of parameters in any order, leaving out those to be
+ * excluded.
+ */
+void AbsorbQuery(
+    Uri::Hasher& hasher,
+    const char* query,
+    size_t length,
+    const Uri::FingerprintOptions& options,
+    Scratch& scratch
+) {
+    const bool excluding = (
+        options.excludeTrackingParameters
+        || !options.excludedParameters.empty()
+    );
+    query = NormalizeIfNeeded(query, length, scratch);
+    if (!options.unorderedQuery && !excluding) {
+        AbsorbElement(hasher, QueryTag, query, length);
+        return;
+    }
+
+    // Each parameter is hashed on its own, and the hashes are added up,
+    // which is the same in any order.  When the order matters, the
+    // parameters are instead hashed one after another.
+    uint64_t count = 0;
+    Uri::Fingerprint128 sum;
+    Uri::Hasher ordered(options.seed);
+    size_t begin = 0;
+    while (begin <= length) {
+        const auto ampersand = (const char*)memchr(query + begin, '&', length - begin);
+        const size_t end = (ampersand == nullptr) ? length : (size_t)(ampersand - query);
+        const char* const parameter = query + begin;
+        const size_t parameterLength = end - begin;
+        if ((parameterLength > 0) && !IsExcluded(parameter, parameterLength, options)) {
+            ++count;
+            if (options.unorderedQuery) {
+                Uri::Hasher parameterHasher(options.seed);
+                parameterHasher.Absorb(parameter, parameterLength);
+                const auto parameterHash = parameterHasher.Finish();
+                sum.low += parameterHash.low;
+                sum.high += parameterHash.high;
+            } else {
+                ordered.Absorb((uint64_t)parameterLength);
+                ordered.Absorb(parameter, parameterLength);
+            }
+        }
+        begin = end + 1;
+    }
+    if (!options.unorderedQuery) {
+        sum = ordered.Finish();
+    }
+    hasher.Absorb((uint64_t)QueryTag | (count << 8));
+    hasher.Absorb(sum.low);
+    hasher.Absorb(sum.high);
+}
+}
+
+namespace Uri
+{
+Fingerprint128 FingerprintElements(
+    const char* data,
+    const Elements& elements,
+    const FingerprintOptions& options
+) {
+    Hasher hasher(options.seed);
+    Scratch scratch;
+
+    // The scheme is needed to know its default port,
+    // even if it's not itself in the fingerprint.
+    char scheme[16];
+    size_t schemeLength = 0;
+    uint16_t defaultPort = 0;
+    bool knownScheme = false;
+    if (elements.hasScheme) {
+        if (elements.scheme.Length() <= sizeof(scheme)) {
+            schemeLength = NormalizeLowercase(data, elements.scheme.Length(), scheme);
+            knownScheme = GetDefaultPort(scheme, schemeLength, defaultPort);
+            if ((options.elements & FINGERPRINT_SCHEME) != 0) {
+                AbsorbElement(hasher, SchemeTag, scheme, schemeLength);
+            }
+        } else if ((options.elements & FINGERPRINT_SCHEME) != 0) {
+            scratch.resize(elements.scheme.Length());
+            schemeLength = NormalizeLowercase(data, elements.scheme.Length(), scratch.data());
+            AbsorbElement(hasher, SchemeTag, scratch.data(), schemeLength);
+        }
+    }
+    if (elements.hasAuthority) {
+        if (
+            elements.hasUserInfo
+            && ((options.elements & FINGERPRINT_USER_INFO) != 0)
+        ) {
+            size_t length = elements.userInfo.Length();
+            const auto userInfo = NormalizeIfNeeded(data + elements.userInfo.begin, length, scratch);
+            AbsorbElement(hasher, UserInfoTag, userInfo, length);
+        }
+        if ((options.elements & FINGERPRINT_HOST) != 0) {
+            scratch.resize(elements.host.Length());
+            const size_t length = NormalizeLowercase(
+                data + elements.host.begin,
+                elements.host.Length(),
+                scratch.data()
+            );
+            AbsorbElement(hasher, HostTag, scratch.data(), length);
+        }
+        if (
+            elements.hasPort
+            && (elements.path.begin - elements.host.end > 1)
+            && (!knownScheme || (elements.port != defaultPort))
+            && ((options.elements & FINGERPRINT_PORT) != 0)
+        ) {
+            hasher.Absorb((uint64_t)PortTag | ((uint64_t)elements.port << 8));
+        }
+    }
+    if ((options.elements & FINGERPRINT_PATH) != 0) {
+        size_t length = elements.path.Length();
+        const char* path = data + elements.path.begin;
+        if (
+            elements.hasScheme
+            && (
+                HasDotSegments(path, length)
+                || (memchr(path, '%', length) != nullptr)
+            )
+        ) {
+            scratch.resize(length);
+            length = NormalizePercentEncoding(path, length, scratch.data());
+            length = RemoveDotSegments(scratch.data(), length, scratch.data());
+            if (!elements.hasAuthority) {
+                length = KeepPathFromLookingLikeAuthority(scratch.data(), length);
+            }
+            path = scratch.data();
+        } else {
+            path = NormalizeIfNeeded(path, length, scratch);
+        }
+        if ((length == 0) && elements.hasAuthority && knownScheme) {
+            path = "/";
+            length = 1;
+        }
+        AbsorbElement(hasher, PathTag, path, length);
+    }
+    if (elements.hasQuery && ((options.elements & FINGERPRINT_QUERY) != 0)) {
+        AbsorbQuery(
+            hasher,
+            data + elements.query.begin,
+            elements.query.Length(),
+            options,
+            scratch
+        );
+    }
+    if (elements.hasFragment && ((options.elements & FINGERPRINT_FRAGMENT) != 0)) {
+        size_t length = elements.fragment.Length();
+        const auto fragment = NormalizeIfNeeded(data + elements.fragment.begin, length, scratch);
+        AbsorbElement(hasher, FragmentTag, fragment, length);
+    }
+    return hasher.Finish();
+}
+
+bool Fingerprint(
+    const char* data,
+    size_t length,
+    const FingerprintOptions& options,
+    Fingerprint128& fingerprint
+) {
+    Parser parser;
+    if (!parser.Parse(data, length)) {
+        return false;
+    }
+    fingerprint = FingerprintElements(data, parser.elements, options);
+    return true;
+}
+
+bool Fingerprint(
+    const char* data,
+    size_t length,
+    const FingerprintOptions& options,
+    uint64_t& fingerprint
+) {
+    Fingerprint128 fingerprint128;
+    if (!Fingerprint(data, length, options, fingerprint128)) {
+        return false;
+    }
+    fingerprint = fingerprint128.low;
+    return true;
+}
+
+void Fingerprint(
+    const Uri& uri,
+    const FingerprintOptions& options,
+    uint64_t& fingerprint
+) {
+    Fingerprint128 fingerprint128;
+    Fingerprint(uri, options, fingerprint128);
+    fingerprint = fingerprint128.low;
+}
+} // namespace Uri
@@ -0,0 +1,40 @@
+#ifndef URI_FINGERPRINT_ELEMENTS_HPP
+#define URI_FINGERPRINT_ELEMENTS_HPP
+
+/**
+ * @file FingerprintElements.hpp
+ *
+ * This module declares the function which computes the fingerprint
+ * of selected elements of a URI once the parser has found them.
+ */
+
+#include "Parser.hpp"
+
+#include <Uri/Fingerprint.hpp>
+
+namespace Uri
+{
+/**
+ * This function computes the fingerprint of selected elements
+ * of a parsed URI.
+ *
+ * @param[in] data
+ *     This points to the characters of the URI.
+ *
+ * @param[in] elements
+ *     This holds where the elements of the URI are.
+ *
+ * @param[in] options
+ *     These are the choices of what goes into the fingerprint.
+ *
+ * @return
+ *     The fingerprint is returned.
+ */
+Fingerprint128 FingerprintElements(
+    const char* data,
+    const Elements& elements,
+    const FingerprintOptions& options
+);
+} // namespace Uri
+
+#endif /* URI_FINGERPRINT_ELEMENTS_HPP */
@@ -0,0 +1,159 @@
+#ifndef URI_HASHER_HPP
+#define URI_HASHER_HPP
+
+/**
+ * @file Hasher.hpp
+ *
+ * This module declares the Uri::Hasher class, a fast, non-cryptographic
+ * hash function which takes its input in pieces.
+ */
+
+#include <Uri/Fingerprint.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace Uri
+{
+/**
+ * This function multiplies the given numbers, and folds the high half
+ * of the 128-bit product into the low half, mixing every bit of both
+ * into every bit of the result.
+ */
+inline uint64_t FoldedMultiply(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    const auto product = (unsigned __int128)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    const uint64_t aLow = (uint32_t)a;
+    const uint64_t aHigh = a >> 32;
+    const uint64_t bLow = (uint32_t)b;
+    const uint64_t bHigh = b >> 32;
+    const uint64_t lowLow = aLow * bLow;
+    const uint64_t lowHigh = aLow * bHigh;
+    const uint64_t highLow = aHigh * bLow;
+    const uint64_t highHigh = aHigh * bHigh;
+    const uint64_t middle = (lowLow >> 32) + (uint32_t)lowHigh + (uint32_t)highLow;
+    const uint64_t low = (middle << 32) | (uint32_t)lowLow;
+    const uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+/**
+ * These are the odd constants, with bits well spread out, with
+ * which the lanes of Hasher are mixed.
+ */
+constexpr uint64_t HASHER_CONSTANTS[8] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+    0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL,
+    0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL,
+    0x94d049bb133111ebULL, 0xd6e8feb86659fd93ULL,
+};
+
+/**
+ * This class computes a 128-bit hash of characters given to it in
+ * any number of pieces, a 16-character stripe at a time, with one
+ * 64-by-64-bit multiplication for each of two lanes per stripe.
+ *
+ * The hash is the same however the characters are split into pieces.
+ */
+class Hasher {
+public:
+    /**
+     * This constructs a hasher with the given seed.
+     */
+    explicit Hasher(uint64_t seed = 0) {
+        lanes_[0] = seed ^ HASHER_CONSTANTS[0];
+        lanes_[1] = FoldedMultiply(seed ^ HASHER_CONSTANTS[1], HASHER_CONSTANTS[2]);
+    }
+
+    /**
+     * This method adds the given characters to the hash.
+     */
+    void Absorb(const char* data, size_t length) {
+        length_ += length;
+        if (pendingLength_ > 0) {
+            const size_t fill = (
+                (length < STRIPE - pendingLength_) ? length : (STRIPE - pendingLength_)
+            );
+            memcpy(pending_ + pendingLength_, data, fill);
+            pendingLength_ += fill;
+            data += fill;
+            length -= fill;
+            if (pendingLength_ < STRIPE) {
+                return;
+            }
+            MixStripe(pending_);
+            pendingLength_ = 0;
+        }
+        while (length >= STRIPE) {
+            MixStripe(data);
+            data += STRIPE;
+            length -= STRIPE;
+        }
+        memcpy(pending_, data, length);
+        pendingLength_ = length;
+    }
+
+    /**
+     * This method adds the given number to the hash,
+     * as its eight bytes.
+     */
+    void Absorb(uint64_t value) {
+        Absorb((const char*)&value, sizeof(value));
+    }
+
+    /**
+     * This method returns the hash of everything added so far.
+     */
+    Fingerprint128 Finish() const {
+        uint64_t lanes[2] = {lanes_[0], lanes_[1]};
+        if (pendingLength_ > 0) {
+            char last[STRIPE] = {0};
+            memcpy(last, pending_, pendingLength_);
+            Mix(lanes, last);
+        }
+        const uint64_t x = FoldedMultiply(lanes[0] ^ HASHER_CONSTANTS[4], lanes[1] ^ length_ ^ HASHER_CONSTANTS[5]);
+        const uint64_t y = FoldedMultiply(lanes[1] ^ HASHER_CONSTANTS[6], lanes[0] ^ HASHER_CONSTANTS[7]);
+        Fingerprint128 hash;
+        hash.low = FoldedMultiply(x ^ HASHER_CONSTANTS[0], y ^ HASHER_CONSTANTS[2]);
+        hash.high = FoldedMultiply(y ^ HASHER_CONSTANTS[1], x ^ HASHER_CONSTANTS[3]);
+        return hash;
+    }
+
+private:
+    /**
+     * This is the number of characters mixed into the lanes at once.
+     */
+    static constexpr size_t STRIPE = 16;
+
+    /**
+     * This function mixes the given stripe of characters
+     * into the given lanes.
+     */
+    static void Mix(uint64_t (&lanes)[2], const char* stripe) {
+        uint64_t a;
+        uint64_t b;
+        memcpy(&a, stripe, sizeof(a));
+        memcpy(&b, stripe + sizeof(a), sizeof(b));
+        lanes[0] = FoldedMultiply(a ^ lanes[0] ^ HASHER_CONSTANTS[0], b ^ HASHER_CONSTANTS[1]);
+        lanes[1] = FoldedMultiply(b ^ lanes[1] ^ HASHER_CONSTANTS[2], ((a << 29) | (a >> 35)) ^ HASHER_CONSTANTS[3]);
+    }
+
+    /**
+     * This method mixes the given stripe of characters into the lanes.
+     */
+    void MixStripe(const char* stripe) {
+        Mix(lanes_, stripe);
+    }
+
+    uint64_t lanes_[2];
+    uint64_t length_ = 0;
+    char pending_[STRIPE];
+    size_t pendingLength_ = 0;
+};
+} // namespace Uri
+
+#endif /* URI_HASHER_HPP */
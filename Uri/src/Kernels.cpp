@@ -0,0 +1,198 @@
+/**
+ * @file Kernels.cpp
+ *
+ * This module contains the implementation of the functions which
+ * pick the kernels used by the Uri library.
+ */
+
+#include "Kernels.hpp"
+
+#include "DelimiterScan.hpp"
+#include "EscapeScan.hpp"
+#include "PercentScan.hpp"
+#include "QueryScan.hpp"
+
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(URI_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+/**
+ * These are the kernels of each kernel set, in the same order
+ * as the KernelSet enumeration.  SSE2 has no byte shuffle with which
+ * to look up arbitrary sets of characters, so its set uses the
+ * portable kernel for finding characters to percent-encode.
+ */
+const Uri::Kernels kernelTables[] = {
+    {
+        Uri::KernelSet::Scalar,
+        Uri::ScanDelimitersScalar,
+        Uri::ScanPercentsScalar,
+        Uri::ScanEscapesScalar,
+        Uri::ScanQuerySeparatorsScalar,
+    },
+#if defined(URI_X86)
+    {
+        Uri::KernelSet::Sse2,
+        Uri::ScanDelimitersSse2,
+        Uri::ScanPercentsSse2,
+        Uri::ScanEscapesScalar,
+        Uri::ScanQuerySeparatorsSse2,
+    },
+    {
+        Uri::KernelSet::Avx2,
+        Uri::ScanDelimitersAvx2,
+        Uri::ScanPercentsAvx2,
+        Uri::ScanEscapesAvx2,
+        Uri::ScanQuerySeparatorsAvx2,
+    },
+    {
+        Uri::KernelSet::Avx512,
+        Uri::ScanDelimitersAvx512,
+        Uri::ScanPercentsAvx512,
+        Uri::ScanEscapesAvx512,
+        Uri::ScanQuerySeparatorsAvx512,
+    },
+#endif
+};
+
+/**
+ * These are the names of the kernel sets, in the same order
+ * as the KernelSet enumeration.
+ */
+const char* const kernelSetNames[] = {
+    "scalar",
+    "sse2",
+    "avx2",
+    "avx512",
+};
+
+/**
+ * This points to the kernels currently in use, or is null
+ * if they haven't been picked yet.
+ */
+std::atomic< const Uri::Kernels* > activeKernels(nullptr);
+
+#if defined(URI_X86) && defined(_MSC_VER)
+/**
+ * This function determines whether or not the processor supports
+ * the given kernel set, by asking it directly, and checking that the
+ * operating system saves the vector registers the kernels use.
+ */
+bool CpuSupports(Uri::KernelSet kernelSet) {
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = ((info[3] & (1 << 26)) != 0);
+    const bool osxsave = ((info[2] & (1 << 27)) != 0);
+    if (kernelSet == Uri::KernelSet::Sse2) {
+        return sse2;
+    }
+    if (!osxsave || (maxLeaf < 7)) {
+        return false;
+    }
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (kernelSet == Uri::KernelSet::Avx2) {
+        return (
+            ((xcr0 & 0x06) == 0x06)
+            && ((info[1] & (1 << 5)) != 0)
+        );
+    }
+    return (
+        ((xcr0 & 0xE6) == 0xE6)
+        && ((info[1] & (1 << 16)) != 0)
+        && ((info[1] & (1 << 30)) != 0)
+    );
+}
+#elif defined(URI_X86)
+/**
+ * This function determines whether or not the processor supports
+ * the given kernel set, using the compiler's built-in detection.
+ */
+bool CpuSupports(Uri::KernelSet kernelSet) {
+    __builtin_cpu_init();
+    switch (kernelSet) {
+        case Uri::KernelSet::Sse2: return __builtin_cpu_supports("sse2");
+        case Uri::KernelSet::Avx2: return __builtin_cpu_supports("avx2");
+        case Uri::KernelSet::Avx512: return (
+            __builtin_cpu_supports("avx512f")
+            && __builtin_cpu_supports("avx512bw")
+        );
+        default: return false;
+    }
+}
+#endif
+
+/**
+ * This function picks the kernels to use when none have been
+ * selected: the best the processor supports, unless overridden
+ * by the URI_KERNELS environment variable.
+ */
+const Uri::Kernels* PickKernels() {
+    Uri::KernelSet best = Uri::KernelSet::Scalar;
+    for (const auto& kernels: kernelTables) {
+        if (Uri::IsKernelSetSupported(kernels.kernelSet)) {
+            best = kernels.kernelSet;
+        }
+    }
+    const char* override = getenv("URI_KERNELS");
+    if (override != nullptr) {
+        for (const auto& kernels: kernelTables) {
+            if (
+                (strcmp(override, kernelSetNames[(int)kernels.kernelSet]) == 0)
+                && Uri::IsKernelSetSupported(kernels.kernelSet)
+            ) {
+                best = kernels.kernelSet;
+            }
+        }
+    }
+    return &kernelTables[(int)best];
+}
+}
+
+namespace Uri
+{
+const Kernels& GetKernels() {
+    auto kernels = activeKernels.load(std::memory_order_acquire);
+    if (kernels == nullptr) {
+        const Kernels* picked = PickKernels();
+        if (activeKernels.compare_exchange_strong(kernels, picked)) {
+            kernels = picked;
+        }
+    }
+    return *kernels;
+}
+
+KernelSet GetKernelSet() {
+    return GetKernels().kernelSet;
+}
+
+const char* GetKernelSetName(KernelSet kernelSet) {
+    return kernelSetNames[(int)kernelSet];
+}
+
+bool IsKernelSetSupported(KernelSet kernelSet) {
+    if (kernelSet == KernelSet::Scalar) {
+        return true;
+    }
+#if defined(URI_X86)
+    return CpuSupports(kernelSet);
+#else
+    return false;
+#endif
+}
+
+bool SelectKernelSet(KernelSet kernelSet) {
+    if (!IsKernelSetSupported(kernelSet)) {
+        return false;
+    }
+    activeKernels.store(&kernelTables[(int)kernelSet], std::memory_order_release);
+    return true;
+}
+} // namespace Uri
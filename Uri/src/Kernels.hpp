@@ -0,0 +1,79 @@
+#ifndef URI_PRIVATE_KERNELS_HPP
+#define URI_PRIVATE_KERNELS_HPP
+
+/**
+ * @file Kernels.hpp
+ *
+ * This module declares the Uri::Kernels structure, through which
+ * the inner loops of the library are dispatched to implementations
+ * specialized for the instruction sets the processor supports.
+ */
+
+#include <Uri/Kernels.hpp>
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+/**
+ * This is defined when building for an x86 processor, for which
+ * vectorized kernels are available.
+ */
+#define URI_X86
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define URI_TARGET(features)
+#else
+/**
+ * This marks a function as using the given instruction set
+ * extensions, so it can be compiled for them even though the rest
+ * of the library is not.  It must only be called after checking
+ * that the processor supports them.
+ */
+#define URI_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace Uri
+{
+/**
+ * This holds the kernels of one kernel set.
+ */
+struct Kernels {
+    /**
+     * This is the kernel set to which the kernels belong.
+     */
+    KernelSet kernelSet;
+
+    /**
+     * This is the kernel which classifies a block of characters
+     * (see ScanDelimiters).
+     */
+    uint64_t (*scanDelimiters)(const char* data);
+
+    /**
+     * This is the kernel which finds the "%" characters in a block
+     * of characters (see ScanPercents).
+     */
+    uint64_t (*scanPercents)(const char* data);
+
+    /**
+     * This is the kernel which finds the characters in a block of
+     * characters which need to be percent-encoded (see ScanEscapes).
+     */
+    uint64_t (*scanEscapes)(const char* data, const uint8_t* lowNibbleBits);
+
+    /**
+     * This is the kernel which finds the "&" and "=" characters
+     * in a block of characters (see ScanQuerySeparators).
+     */
+    uint64_t (*scanQuerySeparators)(const char* data);
+};
+
+/**
+ * This function returns the kernels currently in use,
+ * picking them the first time it's called.
+ */
+const Kernels& GetKernels();
+} // namespace Uri
+
+#endif /* URI_PRIVATE_KERNELS_HPP */
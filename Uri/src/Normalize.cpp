@@ -0,0 +1,251 @@
+/**
+ * @file Normalize.cpp
+ *
+ * This module contains the implementation of the function which
+ * normalizes a URI.
+ */
+
+#include "Normalize.hpp"
+
+#include "Resolve.hpp"
+
+#include <Uri/CharacterClasses.hpp>
+
+#include <string.h>
+
+namespace {
+/**
+ * These are the uppercase hexadecimal digits, by value.
+ */
+constexpr char hexDigits[] = "0123456789ABCDEF";
+
+/**
+ * This describes a scheme with a default port.
+ */
+struct KnownScheme {
+    const char* name;
+    uint16_t defaultPort;
+};
+
+/**
+ * These are the schemes known to have a default port.
+ */
+constexpr KnownScheme knownSchemes[] = {
+    {"http", 80},
+    {"https", 443},
+    {"ws", 80},
+    {"wss", 443},
+    {"ftp", 21},
+};
+
+/**
+ * This function copies the percent-encoded octet at the given position
+ * to the output, decoding it if it's an unreserved character, or
+ * making its hexadecimal digits uppercase otherwise.
+ *
+ * @return
+ *     The position just after the characters written is returned.
+ */
+size_t NormalizePercentEncoded(
+    const char* data,
+    bool lowercase,
+    char* output,
+    size_t position
+) {
+    const auto value = (Uri::HexValue(data[1]) << 4) | Uri::HexValue(data[2]);
+    const auto decoded = (char)value;
+    if (
+        (value < 0x80)
+        && Uri::CharacterClasses::Is(decoded, Uri::CharacterClasses::UNRESERVED)
+    ) {
+        output[position++] = lowercase ? Uri::ToLower(decoded) : decoded;
+    } else {
+        output[position++] = '%';
+        output[position++] = hexDigits[value >> 4];
+        output[position++] = hexDigits[value & 0x0F];
+    }
+    return position;
+}
+
+/**
+ * This function copies the given range of characters to the given
+ * position of the output, normalizing the percent-encoded octets.
+ *
+ * @return
+ *     The position just after the characters written is returned.
+ */
+size_t AppendNormalized(
+    const char* data,
+    const Uri::UriView::Range& range,
+    char* output,
+    size_t position
+) {
+    return position + Uri::NormalizePercentEncoding(
+        data + range.begin,
+        range.Length(),
+        output + position
+    );
+}
+
+/**
+ * This function copies the given range of characters to the given
+ * position of the output, making them lowercase, and normalizing
+ * the percent-encoded octets.
+ *
+ * @return
+ *     The position just after the characters written is returned.
+ */
+size_t AppendLowercaseNormalized(
+    const char* data,
+    const Uri::UriView::Range& range,
+    char* output,
+    size_t position
+) {
+    return position + Uri::NormalizeLowercase(
+        data + range.begin,
+        range.Length(),
+        output + position
+    );
+}
+}
+
+namespace Uri
+{
+bool GetDefaultPort(const char* scheme, size_t length, uint16_t& defaultPort) {
+    for (const auto& knownScheme: knownSchemes) {
+        if (
+            (strlen(knownScheme.name) == length)
+            && (memcmp(knownScheme.name, scheme, length) == 0)
+        ) {
+            defaultPort = knownScheme.defaultPort;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t NormalizePercentEncoding(const char* data, size_t length, char* output) {
+    size_t read = 0;
+    size_t written = 0;
+    while (read < length) {
+        const auto percent = (const char*)memchr(data + read, '%', length - read);
+        const size_t runEnd = (percent == nullptr) ? length : (size_t)(percent - data);
+        memcpy(output + written, data + read, runEnd - read);
+        written += runEnd - read;
+        if (percent == nullptr) {
+            break;
+        }
+        written = NormalizePercentEncoded(percent, false, output, written);
+        read = runEnd + 3;
+    }
+    return written;
+}
+
+size_t NormalizeLowercase(const char* data, size_t length, char* output) {
+    size_t written = 0;
+    for (size_t read = 0; read < length; ++read) {
+        if (data[read] == '%') {
+            written = NormalizePercentEncoded(data + read, true, output, written);
+            read += 2;
+        } else {
+            output[written++] = ToLower(data[read]);
+        }
+    }
+    return written;
+}
+
+Elements NormalizeElements(
+    const char* data,
+    const Elements& elements,
+    char* output
+) {
+    Elements target;
+    size_t position = 0;
+    bool knownScheme = false;
+    uint16_t defaultPort = 0;
+    if (elements.hasScheme) {
+        target.hasScheme = true;
+        position = AppendLowercaseNormalized(data, elements.scheme, output, position);
+        target.scheme.end = position;
+        output[position++] = ':';
+        knownScheme = GetDefaultPort(output, target.scheme.end, defaultPort);
+    }
+    if (elements.hasAuthority) {
+        target.hasAuthority = true;
+        output[position++] = '/';
+        output[position++] = '/';
+        if (elements.hasUserInfo) {
+            target.hasUserInfo = true;
+            target.userInfo.begin = position;
+            position = AppendNormalized(data, elements.userInfo, output, position);
+            target.userInfo.end = position;
+            output[position++] = '@';
+        }
+        target.host.begin = position;
+        position = AppendLowercaseNormalized(data, elements.host, output, position);
+        target.host.end = position;
+        if (!elements.hasUserInfo) {
+            target.userInfo.begin = target.userInfo.end = target.host.begin;
+        }
+        if (
+            elements.hasPort
+            && (elements.path.begin - elements.host.end > 1)
+            && (!knownScheme || (elements.port != defaultPort))
+        ) {
+            target.hasPort = true;
+            target.port = elements.port;
+            char digits[5];
+            size_t numDigits = 0;
+            unsigned int value = elements.port;
+            do {
+                digits[numDigits++] = (char)('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            output[position++] = ':';
+            while (numDigits > 0) {
+                output[position++] = digits[--numDigits];
+            }
+        }
+    }
+    target.path.begin = position;
+    position = AppendNormalized(data, elements.path, output, position);
+    if (elements.hasScheme) {
+        position = target.path.begin + RemoveDotSegments(
+            output + target.path.begin,
+            position - target.path.begin,
+            output + target.path.begin
+        );
+        if (!elements.hasAuthority) {
+            position = target.path.begin + KeepPathFromLookingLikeAuthority(
+                output + target.path.begin,
+                position - target.path.begin
+            );
+        }
+    }
+    if (
+        (position == target.path.begin)
+        && elements.hasAuthority
+        && knownScheme
+    ) {
+        output[position++] = '/';
+    }
+    target.path.end = position;
+    if (elements.hasQuery) {
+        output[position++] = '?';
+        target.hasQuery = true;
+        target.query.begin = position;
+        position = AppendNormalized(data, elements.query, output, position);
+        target.query.end = position;
+    }
+    if (elements.hasFragment) {
+        output[position++] = '#';
+        target.hasFragment = true;
+        target.fragment.begin = position;
+        position = AppendNormalized(data, elements.fragment, output, position);
+    } else {
+        target.fragment.begin = position;
+    }
+    target.fragment.end = position;
+    return target;
+}
+} // namespace Uri
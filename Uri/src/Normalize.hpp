@@ -0,0 +1,162 @@
+#ifndef URI_NORMALIZE_HPP
+#define URI_NORMALIZE_HPP
+
+/**
+ * @file Normalize.hpp
+ *
+ * This module declares the function which normalizes a URI, as
+ * described in RFC 3986 section 6.2.2, so that URIs which are the
+ * same but for how they're written come out as the same string.
+ */
+
+#include "Parser.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace Uri
+{
+/**
+ * This function returns the most characters which normalizing a URI
+ * with the given number of characters could produce.
+ */
+inline size_t GetMaxNormalizedLength(size_t length) {
+    // Normalizing never makes anything longer, except that a "/"
+    // may be given to an empty path.
+    return length + 1;
+}
+
+/**
+ * This function returns the lowercase form of the given character.
+ */
+inline char ToLower(char c) {
+    return ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * This function returns the value of the given hexadecimal digit,
+ * which the parser has already checked is one.
+ */
+inline unsigned int HexValue(char c) {
+    return (
+        (c <= '9') ? (unsigned int)(c - '0') : (
+            (unsigned int)(ToLower(c) - 'a' + 10)
+        )
+    );
+}
+
+/**
+ * This function puts "/." in front of the given path of a URI without
+ * an authority, if removing its dot segments has left it beginning
+ * with "//", since it would otherwise be read back as an authority
+ * (this is what the WHATWG URL Standard does as well).
+ *
+ * @param[in,out] path
+ *     This points to the characters of the path, with room for two
+ *     more, which removing the dot segments has always made when
+ *     it has left the path beginning with "//".
+ *
+ * @param[in] length
+ *     This is the number of characters of the path.
+ *
+ * @return
+ *     The number of characters of the path is returned.
+ */
+inline size_t KeepPathFromLookingLikeAuthority(char* path, size_t length) {
+    if ((length < 2) || (path[0] != '/') || (path[1] != '/')) {
+        return length;
+    }
+    memmove(path + 2, path, length);
+    path[1] = '.';
+    return length + 2;
+}
+
+/**
+ * This function returns the default port of the given scheme,
+ * which must already be lowercase, if it's known to have one.
+ *
+ * @param[in] scheme
+ *     This points to the characters of the scheme.
+ *
+ * @param[in] length
+ *     This is the number of characters of the scheme.
+ *
+ * @param[out] defaultPort
+ *     This is where to put the default port of the scheme.
+ *
+ * @return
+ *     An indication of whether or not the scheme is known
+ *     to have a default port is returned.
+ */
+bool GetDefaultPort(const char* scheme, size_t length, uint16_t& defaultPort);
+
+/**
+ * This function copies the given characters to the given output,
+ * making the hexadecimal digits of percent-encoded octets uppercase,
+ * and decoding those of unreserved characters (RFC 3986 sections
+ * 6.2.2.1 and 6.2.2.2).  Runs without a "%" are copied as they are.
+ *
+ * @param[in] data
+ *     This points to the characters to copy, whose percent-encoded
+ *     octets the parser has already checked.
+ *
+ * @param[in] length
+ *     This is the number of characters to copy.
+ *
+ * @param[out] output
+ *     This points to where to put the characters, which must have room
+ *     for the given number of characters, and must not overlap them.
+ *
+ * @return
+ *     The number of characters written is returned.
+ */
+size_t NormalizePercentEncoding(const char* data, size_t length, char* output);
+
+/**
+ * This function is the same as NormalizePercentEncoding, except that
+ * it also makes every letter lowercase, other than the hexadecimal
+ * digits of percent-encoded octets, as for a scheme or host.
+ */
+size_t NormalizeLowercase(const char* data, size_t length, char* output);
+
+/**
+ * This function normalizes a parsed URI, putting the characters of
+ * the normalized URI together in the given output, in one pass over
+ * the elements of the URI:
+ *
+ * - The scheme and host are made lowercase (section 6.2.2.1).
+ * - The hexadecimal digits of percent-encoded octets are made
+ *   uppercase (section 6.2.2.1).
+ * - Percent-encoded octets of unreserved characters are decoded
+ *   (section 6.2.2.2).
+ * - The dot segments of the path of a URI with a scheme are removed
+ *   (section 6.2.2.3), and a path without an authority which this
+ *   leaves beginning with "//" is given "/." in front.
+ * - An empty port, or the default port of a scheme known to have one,
+ *   is left out, and an empty path of such a scheme, with an
+ *   authority, is made "/" (section 6.2.3).
+ *
+ * @param[in] data
+ *     This points to the characters of the URI.
+ *
+ * @param[in] elements
+ *     This holds where the elements of the URI are.
+ *
+ * @param[out] output
+ *     This points to where to put the characters of the normalized
+ *     URI, which must have room for the number of characters returned
+ *     by GetMaxNormalizedLength, and must not overlap the URI.
+ *
+ * @return
+ *     Where the elements of the normalized URI are in the output is
+ *     returned.  The normalized URI ends where its fragment ends.
+ */
+Elements NormalizeElements(
+    const char* data,
+    const Elements& elements,
+    char* output
+);
+} // namespace Uri
+
+#endif /* URI_NORMALIZE_HPP */
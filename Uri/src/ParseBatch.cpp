@@ -0,0 +1,163 @@
+/**
+ * @file ParseBatch.cpp
+ *
+ * This module contains the implementation of the Uri::ParseBatch
+ * function and the Uri::BatchResults structure.
+ */
+
+#include <Uri/ParseBatch.hpp>
+
+#include "Parser.hpp"
+#include "WorkStealing.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * This is the number of valid URIs parsed by one thread, padded out
+ * to the size of a cache line, so that threads adding to their own
+ * counts don't keep taking the same line from each other.
+ */
+struct ThreadCount {
+    size_t count = 0;
+    char padding[64 - sizeof(size_t)];
+};
+
+/**
+ * This function parses the URIs of a batch from the given one up to,
+ * but not including, the other given one, into results which already
+ * have room for them.
+ *
+ * The number of the first URI must be a multiple of 64, so that
+ * every word of the validity bitmap written holds bits only of URIs
+ * in the range, and ranges may be parsed at the same time.
+ *
+ * @return
+ *     The number of URIs parsed which are valid is returned.
+ */
+size_t ParseBatchRange(
+    const char* buffer,
+    const size_t* offsets,
+    size_t begin,
+    size_t end,
+    Uri::BatchResults& results
+) {
+    // The arrays are written through local pointers, so that the
+    // compiler knows that writing one doesn't change where the
+    // others are, and can keep them all in registers.
+    uint32_t* const schemeEnd = results.schemeEnd.data();
+    uint32_t* const hostBegin = results.hostBegin.data();
+    uint32_t* const hostEnd = results.hostEnd.data();
+    uint16_t* const port = results.port.data();
+    uint32_t* const pathBegin = results.pathBegin.data();
+    uint32_t* const pathEnd = results.pathEnd.data();
+    uint32_t* const queryBegin = results.queryBegin.data();
+    uint32_t* const queryEnd = results.queryEnd.data();
+    uint32_t* const fragmentBegin = results.fragmentBegin.data();
+    uint32_t* const fragmentEnd = results.fragmentEnd.data();
+    uint8_t* const flags = results.flags.data();
+    uint64_t* const valid = results.valid.data();
+    size_t numValid = 0;
+    uint64_t validBits = 0;
+    for (size_t i = begin; i < end; ++i) {
+        Uri::Parser parser;
+        if (parser.Parse(buffer + offsets[i], offsets[i + 1] - offsets[i])) {
+            const auto& elements = parser.elements;
+            schemeEnd[i] = (uint32_t)elements.scheme.end;
+            hostBegin[i] = (uint32_t)elements.host.begin;
+            hostEnd[i] = (uint32_t)elements.host.end;
+            port[i] = elements.port;
+            pathBegin[i] = (uint32_t)elements.path.begin;
+            pathEnd[i] = (uint32_t)elements.path.end;
+            queryBegin[i] = (uint32_t)elements.query.begin;
+            queryEnd[i] = (uint32_t)elements.query.end;
+            fragmentBegin[i] = (uint32_t)elements.fragment.begin;
+            fragmentEnd[i] = (uint32_t)elements.fragment.end;
+            flags[i] = (uint8_t)(
+                (elements.hasScheme ? Uri::BatchResults::HasScheme : 0)
+                | (elements.hasAuthority ? Uri::BatchResults::HasAuthority : 0)
+                | (elements.hasPort ? Uri::BatchResults::HasPort : 0)
+                | (elements.hasQuery ? Uri::BatchResults::HasQuery : 0)
+                | (elements.hasFragment ? Uri::BatchResults::HasFragment : 0)
+            );
+            validBits |= ((uint64_t)1 << (i % 64));
+            ++numValid;
+        } else {
+            schemeEnd[i] = 0;
+            hostBegin[i] = hostEnd[i] = 0;
+            port[i] = 0;
+            pathBegin[i] = pathEnd[i] = 0;
+            queryBegin[i] = queryEnd[i] = 0;
+            fragmentBegin[i] = fragmentEnd[i] = 0;
+            flags[i] = 0;
+        }
+        if (((i % 64) == 63) || (i + 1 == end)) {
+            valid[i / 64] = validBits;
+            validBits = 0;
+        }
+    }
+    return numValid;
+}
+}
+
+namespace Uri
+{
+void BatchResults::Resize(size_t newCount) {
+    count = newCount;
+    schemeEnd.resize(newCount);
+    hostBegin.resize(newCount);
+    hostEnd.resize(newCount);
+    port.resize(newCount);
+    pathBegin.resize(newCount);
+    pathEnd.resize(newCount);
+    queryBegin.resize(newCount);
+    queryEnd.resize(newCount);
+    fragmentBegin.resize(newCount);
+    fragmentEnd.resize(newCount);
+    flags.resize(newCount);
+    valid.resize((newCount + 63) / 64);
+}
+
+size_t ParseBatch(
+    const char* buffer,
+    const size_t* offsets,
+    size_t count,
+    BatchResults& results
+) {
+    results.Resize(count);
+    return ParseBatchRange(buffer, offsets, 0, count, results);
+}
+
+size_t ParseBatch(
+    const char* buffer,
+    const size_t* offsets,
+    size_t count,
+    BatchResults& results,
+    const BatchOptions& options
+) {
+    results.Resize(count);
+    const size_t grainSize = (options.grainSize <= 64) ? 64 : (options.grainSize + 63) / 64 * 64;
+    const size_t numChunks = (count + grainSize - 1) / grainSize;
+    size_t numThreads = options.threads;
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    std::vector< ThreadCount > numValidByThread(numThreads < 1 ? 1 : numThreads);
+    RunWorkStealing(
+        numChunks,
+        numThreads,
+        [&](size_t chunk, size_t thread) {
+            const size_t begin = chunk * grainSize;
+            const size_t end = (count - begin < grainSize) ? count : begin + grainSize;
+            const size_t chunkNumValid = ParseBatchRange(buffer, offsets, begin, end, results);
+            numValidByThread[thread].count += chunkNumValid;
+        }
+    );
+    size_t numValid = 0;
+    for (const auto& threadNumValid: numValidByThread) {
+        numValid += threadNumValid.count;
+    }
+    return numValid;
+}
+} // namespace Uri
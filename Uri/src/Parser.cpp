@@ -0,0 +1,856 @@
+/**
+ * @file Parser.cpp
+ *
+ * This module contains the implementation of the Uri::Parser structure.
+ */
+
+#include "Parser.hpp"
+
+#include "BlockFinder.hpp"
+#include "DelimiterScan.hpp"
+
+#include <Uri/CharacterClasses.hpp>
+
+namespace {
+/**
+ * These are the categories into which the parser sorts characters.
+ * Every character in a category is treated the same way by the
+ * grammar of RFC 3986, wherever it appears.
+ */
+enum Category : uint8_t {
+    // HEXDIG letters: "A" through "F" and "a" through "f".
+    HexAlpha,
+
+    // The rest of ALPHA.
+    OtherAlpha,
+
+    // DIGIT.
+    Digit,
+
+    // The scheme characters other than ALPHA and DIGIT: "+", "-", ".".
+    SchemePunctuation,
+
+    // The unreserved characters not already covered: "_", "~".
+    OtherUnreserved,
+
+    // The sub-delims not already covered: "!$&'()*,;=".
+    OtherSubDelimiter,
+
+    // The gen-delims, each of which matters on its own.
+    Colon,
+    Slash,
+    QuestionMark,
+    NumberSign,
+    AtSign,
+    OpenBracket,
+    CloseBracket,
+
+    // The "%" which begins a percent-encoded octet.
+    Percent,
+
+    // Everything else, which may not appear anywhere in a URI.
+    Invalid,
+
+    NumCategories
+};
+
+/**
+ * These are the kinds of bookkeeping the parser does on some
+ * transitions, in addition to changing state.
+ */
+enum Action : uint8_t {
+    None,
+
+    // The colon ending the scheme was consumed.
+    EndScheme,
+
+    // The second slash of the "//" beginning the authority was consumed.
+    BeginAuthority,
+
+    // A colon which may begin the port was consumed.
+    AuthorityColon,
+
+    // A digit which may belong to the port was consumed.
+    TentativePortDigit,
+
+    // A digit which definitely belongs to the port was consumed.
+    PortDigit,
+
+    // The "@" ending the user info was consumed.
+    EndUserInfo,
+
+    // The "/", "?", or "#" ending the authority was consumed.
+    EndAuthority,
+
+    // The "?" beginning the query was consumed.
+    BeginQuery,
+
+    // The "#" beginning the fragment was consumed.
+    BeginFragment,
+
+    // The "%" beginning a percent-encoded octet was consumed.
+    BeginPercentEncoded,
+
+    // The last digit of a percent-encoded octet was consumed.
+    EndPercentEncoded,
+
+    // A character inside the brackets of an IP-literal was consumed.
+    IpLiteralCharacter,
+
+    // The "]" ending an IP-literal was consumed.
+    EndIpLiteral,
+};
+
+/**
+ * This is one entry of the transition table of the parser.
+ */
+struct Transition {
+    /**
+     * This is the state into which the parser moves.
+     */
+    uint8_t next;
+
+    /**
+     * This is the bookkeeping the parser does on the transition.
+     */
+    uint8_t action;
+
+    /**
+     * This is the state into which the parser moves after the
+     * percent-encoded octet begun by this transition, if any.
+     */
+    uint8_t resume;
+};
+
+/**
+ * This function determines which category the given character
+ * belongs to.  Use the categories table instead, which holds the
+ * result for every character.
+ *
+ * @param[in] c
+ *     This is the character to categorize.
+ *
+ * @return
+ *     The category of the character is returned.
+ */
+constexpr uint8_t Categorize(unsigned int c) {
+    using namespace Uri::CharacterClasses;
+    return (
+        Is((char)c, HEXDIG) ? (Is((char)c, ALPHA) ? HexAlpha : Digit) :
+        Is((char)c, ALPHA) ? OtherAlpha :
+        IsOneOf(c, "+-.") ? SchemePunctuation :
+        Is((char)c, UNRESERVED) ? OtherUnreserved :
+        Is((char)c, SUB_DELIMS) ? OtherSubDelimiter :
+        (c == ':') ? Colon :
+        (c == '/') ? Slash :
+        (c == '?') ? QuestionMark :
+        (c == '#') ? NumberSign :
+        (c == '@') ? AtSign :
+        (c == '[') ? OpenBracket :
+        (c == ']') ? CloseBracket :
+        (c == '%') ? Percent :
+        Invalid
+    );
+}
+
+/**
+ * This maps each character to its category.
+ */
+constexpr Uri::CharacterClasses::CharacterTable< uint8_t > categories = (
+    Uri::CharacterClasses::MakeCharacterTable(
+        Categorize,
+        Uri::CharacterClasses::MakeIndexSequence< 256 >()
+    )
+);
+
+/**
+ * This function determines whether or not the given category contains
+ * only characters allowed in a scheme: ALPHA / DIGIT / "+" / "-" / ".".
+ */
+bool IsScheme(Category category) {
+    return (category <= SchemePunctuation);
+}
+
+/**
+ * This function determines whether or not the given category contains
+ * only characters allowed in a reg-name, not counting percent-encoded
+ * octets: unreserved / sub-delims.
+ */
+bool IsRegName(Category category) {
+    return (category <= OtherSubDelimiter);
+}
+
+/**
+ * This function determines whether or not the given category contains
+ * only characters allowed in a path segment, not counting
+ * percent-encoded octets: unreserved / sub-delims / ":" / "@".
+ */
+bool IsPChar(Category category) {
+    return (
+        IsRegName(category)
+        || (category == Colon)
+        || (category == AtSign)
+    );
+}
+
+/**
+ * This function makes a transition into the given state.
+ */
+Transition To(Uri::Parser::State next, Action action = None) {
+    return Transition{(uint8_t)next, (uint8_t)action, (uint8_t)Uri::Parser::Error};
+}
+
+/**
+ * This function makes a transition into the state which consumes
+ * a percent-encoded octet.
+ *
+ * @param[in] resume
+ *     This is the state to resume after the percent-encoded octet.
+ */
+Transition PercentEncodedThen(Uri::Parser::State resume) {
+    return Transition{
+        (uint8_t)Uri::Parser::PercentFirst,
+        (uint8_t)BeginPercentEncoded,
+        (uint8_t)resume
+    };
+}
+
+/**
+ * This function determines the entry of the transition table of the
+ * parser for the given state and character category, implementing
+ * the URI-reference grammar of RFC 3986.
+ *
+ * @param[in] state
+ *     This is the state of the parser.
+ *
+ * @param[in] category
+ *     This is the category of the character being consumed.
+ *
+ * @return
+ *     The entry for the transition table is returned.
+ */
+Transition MakeTransition(Uri::Parser::State state, Category category) {
+    using Uri::Parser;
+    switch (state) {
+        case Parser::Start:
+        case Parser::SchemeOrSegment: {
+            // "scheme" has to start with ALPHA, and the first segment
+            // of a relative path cannot contain a colon.
+            const bool inScheme = (state == Parser::SchemeOrSegment);
+            if (
+                (category == HexAlpha)
+                || (category == OtherAlpha)
+                || (inScheme && IsScheme(category))
+            ) {
+                return To(Parser::SchemeOrSegment);
+            } else if (inScheme && (category == Colon)) {
+                return To(Parser::AfterScheme, EndScheme);
+            } else if (category == Slash) {
+                return To(inScheme ? Parser::Path : Parser::PathOrAuthority);
+            } else if (category == Percent) {
+                return PercentEncodedThen(Parser::FirstSegment);
+            } else if (category != Colon) {
+                return MakeTransition(Parser::FirstSegment, category);
+            }
+        } break;
+
+        case Parser::FirstSegment: {
+            if (category == Colon) {
+                return To(Parser::Error);
+            } else if (IsPChar(category)) {
+                return To(Parser::FirstSegment);
+            } else if (category == Percent) {
+                return PercentEncodedThen(Parser::FirstSegment);
+            }
+            return MakeTransition(Parser::Path, category);
+        } break;
+
+        case Parser::AfterScheme: {
+            if (category == Slash) {
+                return To(Parser::PathOrAuthority);
+            }
+            return MakeTransition(Parser::Path, category);
+        } break;
+
+        case Parser::PathOrAuthority: {
+            if (category == Slash) {
+                return To(Parser::AuthorityStart, BeginAuthority);
+            }
+            return MakeTransition(Parser::Path, category);
+        } break;
+
+        case Parser::AuthorityStart:
+        case Parser::HostStart: {
+            if (category == OpenBracket) {
+                return To(Parser::IpLiteral);
+            }
+            return MakeTransition(
+                (state == Parser::AuthorityStart) ? Parser::Authority : Parser::Host,
+                category
+            );
+        } break;
+
+        case Parser::Authority:
+        case Parser::UserInfoOrPort:
+        case Parser::UserInfo:
+        case Parser::Host:
+        case Parser::Port: {
+            if (
+                (category == Slash)
+                || (category == QuestionMark)
+                || (category == NumberSign)
+            ) {
+                if (state == Parser::UserInfo) {
+                    // The host cannot contain what was consumed.
+                    return To(Parser::Error);
+                }
+                return To(
+                    (category == Slash) ? Parser::Path : (
+                        (category == QuestionMark) ? Parser::Query : Parser::Fragment
+                    ),
+                    EndAuthority
+                );
+            }
+            if (state == Parser::Port) {
+                if (category == Digit) {
+                    return To(Parser::Port, PortDigit);
+                }
+            } else if (category == AtSign) {
+                if (state != Parser::Host) {
+                    return To(Parser::HostStart, EndUserInfo);
+                }
+            } else if (category == Colon) {
+                if (state == Parser::Authority) {
+                    return To(Parser::UserInfoOrPort, AuthorityColon);
+                } else if (state == Parser::Host) {
+                    return To(Parser::Port, AuthorityColon);
+                } else {
+                    return To(Parser::UserInfo);
+                }
+            } else if ((category == Digit) && (state == Parser::UserInfoOrPort)) {
+                return To(Parser::UserInfoOrPort, TentativePortDigit);
+            } else if (IsRegName(category) || (category == Percent)) {
+                const auto next = (
+                    (state == Parser::UserInfoOrPort) ? Parser::UserInfo : state
+                );
+                if (category == Percent) {
+                    return PercentEncodedThen(next);
+                }
+                return To(next);
+            }
+        } break;
+
+        case Parser::IpLiteral: {
+            // Each character is checked against the IPv6address and
+            // IPvFuture grammar, so none is skipped in bulk.
+            if (IsRegName(category) || (category == Colon)) {
+                return To(Parser::IpLiteral, IpLiteralCharacter);
+            } else if (category == CloseBracket) {
+                return To(Parser::AfterIpLiteral, EndIpLiteral);
+            }
+        } break;
+
+        case Parser::AfterIpLiteral: {
+            if (category == Colon) {
+                return To(Parser::Port, AuthorityColon);
+            } else if (category != Digit) {
+                return MakeTransition(Parser::Port, category);
+            }
+        } break;
+
+        case Parser::Path:
+        case Parser::Query:
+        case Parser::Fragment: {
+            if (IsPChar(category) || (category == Slash)) {
+                return To(state);
+            } else if (category == Percent) {
+                return PercentEncodedThen(state);
+            } else if (category == QuestionMark) {
+                if (state == Parser::Path) {
+                    return To(Parser::Query, BeginQuery);
+                }
+                return To(state);
+            } else if ((category == NumberSign) && (state != Parser::Fragment)) {
+                return To(Parser::Fragment, BeginFragment);
+            }
+        } break;
+
+        case Parser::PercentFirst: {
+            if ((category == HexAlpha) || (category == Digit)) {
+                return To(Parser::PercentSecond);
+            }
+        } break;
+
+        case Parser::PercentSecond: {
+            if ((category == HexAlpha) || (category == Digit)) {
+                return To(Parser::Error, EndPercentEncoded);
+            }
+        } break;
+
+        default: break;
+    }
+    return To(Parser::Error);
+}
+
+/**
+ * This function determines why the parser found a character to be
+ * invalid, from the state the parser was in and the category of the
+ * character.  It's only used once the parser has failed, so it's
+ * kept out of the transition table.
+ *
+ * @param[in] state
+ *     This is the state the parser was in.
+ *
+ * @param[in] category
+ *     This is the category of the character consumed.
+ *
+ * @return
+ *     The reason why the character was invalid is returned.
+ */
+Uri::ValidationError Diagnose(Uri::Parser::State state, Category category) {
+    using Uri::Parser;
+    using Uri::ValidationError;
+    const bool endsAuthority = (
+        (category == Slash)
+        || (category == QuestionMark)
+        || (category == NumberSign)
+    );
+    switch (state) {
+        case Parser::PercentFirst:
+        case Parser::PercentSecond: {
+            return ValidationError::BadPercentEncoding;
+        }
+
+        case Parser::Port: {
+            return ValidationError::BadPort;
+        }
+
+        case Parser::UserInfoOrPort:
+        case Parser::UserInfo: {
+            // The authority ended with what came after the colon being
+            // either too large or not all digits, so it wasn't a port.
+            if (endsAuthority) {
+                return ValidationError::BadPort;
+            }
+        } break;
+
+        case Parser::IpLiteral:
+        case Parser::AfterIpLiteral: {
+            return ValidationError::BadIpLiteral;
+        }
+
+        default: break;
+    }
+    if (category == Invalid) {
+        return ValidationError::IllegalCharacter;
+    }
+    return ValidationError::MisplacedCharacter;
+}
+
+/**
+ * These are the tables which drive the parser, other than the
+ * table of character categories.  They are built from the grammar
+ * rules in MakeTransition the first time they are needed.
+ */
+struct Tables {
+    /**
+     * This maps each state and character category
+     * to what the parser does next.
+     */
+    Transition transitions[Uri::Parser::NumStates][NumCategories];
+
+    /**
+     * This marks the states which stay the same, without any
+     * bookkeeping, for every ordinary character (unreserved or
+     * sub-delim).  In these states, runs of ordinary characters
+     * are skipped in bulk rather than stepped through.
+     */
+    bool skipsOrdinary[Uri::Parser::NumStates];
+
+    /**
+     * This constructs the tables.
+     */
+    Tables() {
+        for (int state = 0; state < Uri::Parser::NumStates; ++state) {
+            for (int category = 0; category < NumCategories; ++category) {
+                transitions[state][category] = MakeTransition(
+                    (Uri::Parser::State)state,
+                    (Category)category
+                );
+            }
+            skipsOrdinary[state] = true;
+            for (int category = 0; category <= OtherSubDelimiter; ++category) {
+                const auto& transition = transitions[state][category];
+                if (
+                    (transition.next != state)
+                    || (transition.action != None)
+                ) {
+                    skipsOrdinary[state] = false;
+                }
+            }
+        }
+    }
+};
+
+/**
+ * This function returns the tables which drive the parser,
+ * building them the first time it's called.
+ */
+const Tables& GetTables() {
+    static const Tables tables;
+    return tables;
+}
+
+/**
+ * This finds the characters in a span which are not ordinary,
+ * a block at a time, remembering the block most recently classified
+ * so that successive searches within it cost only a shift.
+ */
+class DelimiterFinder
+    : public Uri::BlockFinder<
+        Uri::BlockScanFn, Uri::PartialBlockScanFn, Uri::DELIMITER_SCAN_BLOCK_SIZE
+    >
+{
+public:
+    /**
+     * This constructs a finder for the given span of characters.
+     */
+    DelimiterFinder(const char* data, size_t length)
+        : BlockFinder(data, length, Uri::GetKernels().scanDelimiters, Uri::ScanDelimitersPartial)
+    {
+    }
+};
+}
+
+namespace Uri
+{
+bool IpLiteralChecker::Consume(char c) {
+    const bool isDigit = ((c >= '0') && (c <= '9'));
+    const bool isHexDigit = (
+        isDigit
+        || ((c >= 'A') && (c <= 'F'))
+        || ((c >= 'a') && (c <= 'f'))
+    );
+    if (form == Unknown) {
+        if ((c == 'v') || (c == 'V')) {
+            form = FutureVersion;
+            return true;
+        }
+        form = Ipv6;
+    }
+    switch (form) {
+        case Ipv6: {
+            if (isHexDigit) {
+                // A single colon may only come before a digit
+                // once a piece has been consumed.
+                if (((colons == 1) && (pieces == 0) && !doubleColon) || (digits == 4)) {
+                    return false;
+                }
+                if (digits == 0) {
+                    decimal = true;
+                    value = 0;
+                }
+                if (!isDigit || ((digits == 1) && (value == 0))) {
+                    decimal = false;
+                } else if (value < 256) {
+                    value = (uint16_t)(value * 10 + (c - '0'));
+                }
+                ++digits;
+                colons = 0;
+                return true;
+            } else if (c == ':') {
+                if (digits > 0) {
+                    digits = 0;
+                    colons = 1;
+                    return (++pieces < 8);
+                } else if (colons == 1) {
+                    if (doubleColon) {
+                        return false;
+                    }
+                    doubleColon = true;
+                    colons = 2;
+                    return true;
+                } else if ((colons == 0) && (pieces == 0)) {
+                    colons = 1;
+                    return true;
+                }
+                return false;
+            } else if (c == '.') {
+                if ((digits == 0) || !decimal || (value > 255)) {
+                    return false;
+                }
+                form = Ipv4;
+                octets = 1;
+                digits = 0;
+                return true;
+            }
+        } break;
+
+        case Ipv4: {
+            if (isDigit) {
+                if ((digits == 3) || ((digits == 1) && (value == 0))) {
+                    return false;
+                }
+                value = (uint16_t)(((digits == 0) ? 0 : value * 10) + (c - '0'));
+                ++digits;
+                return (value <= 255);
+            } else if (c == '.') {
+                if ((digits == 0) || (octets == 3)) {
+                    return false;
+                }
+                ++octets;
+                digits = 0;
+                return true;
+            }
+        } break;
+
+        case FutureVersion: {
+            if (isHexDigit) {
+                digits = 1;
+                return true;
+            } else if ((c == '.') && (digits > 0)) {
+                form = FutureAddress;
+                digits = 0;
+                return true;
+            }
+        } break;
+
+        case FutureAddress: {
+            digits = 1;
+            return true;
+        } break;
+
+        default: break;
+    }
+    return false;
+}
+
+bool IpLiteralChecker::Finish() const {
+    size_t totalPieces = pieces;
+    switch (form) {
+        case Ipv6: {
+            if (digits > 0) {
+                ++totalPieces;
+            } else if (colons != 2) {
+                return false;
+            }
+        } break;
+
+        case Ipv4: {
+            if ((octets != 3) || (digits == 0)) {
+                return false;
+            }
+            totalPieces += 2;
+        } break;
+
+        case FutureAddress: {
+            return (digits > 0);
+        } break;
+
+        default: {
+            return false;
+        }
+    }
+    // The "::" stands for at least one piece.
+    return doubleColon ? (totalPieces <= 7) : (totalPieces == 8);
+}
+
+bool Parser::Consume(const char* data, size_t length) {
+    // The state is kept in a local variable while consuming, rather
+    // than in the member, so that the compiler can keep it in a
+    // register instead of storing it every character.  It's only
+    // written back where a method which looks at it is called.
+    const auto& tables = GetTables();
+    DelimiterFinder delimiters(data, length);
+    State current = state;
+    for (size_t i = 0; (i < length) && (current != Error); ++i) {
+        if (tables.skipsOrdinary[current]) {
+            i = delimiters.Next(i);
+            if (i == length) {
+                break;
+            }
+        }
+        const auto c = (unsigned char)data[i];
+        const auto& transition = tables.transitions[current][categories[(char)c]];
+        auto next = (State)transition.next;
+        if (transition.action != None) {
+            const auto offset = consumed + i;
+            state = current;
+            switch ((Action)transition.action) {
+                case EndScheme: {
+                    elements.hasScheme = true;
+                    elements.scheme.end = offset;
+                    elements.path.begin = offset + 1;
+                } break;
+
+                case BeginAuthority: {
+                    elements.hasAuthority = true;
+                    hostBegin = offset + 1;
+                } break;
+
+                case AuthorityColon: {
+                    portColon = offset;
+                    portValue = 0;
+                    portOverflow = false;
+                } break;
+
+                case TentativePortDigit:
+                case PortDigit: {
+                    if (!portOverflow) {
+                        portValue = portValue * 10 + (uint32_t)(c - '0');
+                        portOverflow = (portValue > 65535);
+                    }
+                    if (portOverflow && (transition.action == PortDigit)) {
+                        next = Error;
+                    }
+                } break;
+
+                case EndUserInfo: {
+                    elements.hasUserInfo = true;
+                    elements.userInfo.begin = hostBegin;
+                    elements.userInfo.end = offset;
+                    hostBegin = offset + 1;
+                } break;
+
+                case EndAuthority: {
+                    if (!EndAuthorityAt(offset)) {
+                        next = Error;
+                        break;
+                    }
+                    elements.path.begin = offset;
+                    if (c == '?') {
+                        BeginQueryAt(offset);
+                    } else if (c == '#') {
+                        BeginFragmentAt(offset);
+                    }
+                } break;
+
+                case BeginQuery: {
+                    BeginQueryAt(offset);
+                } break;
+
+                case BeginFragment: {
+                    BeginFragmentAt(offset);
+                } break;
+
+                case BeginPercentEncoded: {
+                    percentReturn = (State)transition.resume;
+                } break;
+
+                case EndPercentEncoded: {
+                    next = percentReturn;
+                } break;
+
+                case IpLiteralCharacter: {
+                    if (!ipLiteral.Consume((char)c)) {
+                        next = Error;
+                    }
+                } break;
+
+                case EndIpLiteral: {
+                    if (!ipLiteral.Finish()) {
+                        next = Error;
+                    }
+                } break;
+
+                default: break;
+            }
+        }
+        if (next == Error) {
+            state = Error;
+            errorReason = Diagnose(current, (Category)categories[(char)c]);
+            errorOffset = consumed + i;
+            consumed = errorOffset;
+            return false;
+        }
+        current = next;
+    }
+    state = current;
+    consumed += length;
+    return (state != Error);
+}
+
+bool Parser::Finish() {
+    switch (state) {
+        case Start:
+        case SchemeOrSegment:
+        case FirstSegment:
+        case AfterScheme:
+        case PathOrAuthority:
+        case Path: {
+            elements.path.end = consumed;
+        } break;
+
+        case AuthorityStart:
+        case Authority:
+        case UserInfoOrPort:
+        case HostStart:
+        case Host:
+        case Port:
+        case AfterIpLiteral: {
+            if (!EndAuthorityAt(consumed)) {
+                state = Error;
+                errorReason = ValidationError::BadPort;
+                errorOffset = consumed;
+                return false;
+            }
+            elements.path.begin = elements.path.end = consumed;
+        } break;
+
+        case Query: {
+            elements.query.end = consumed;
+        } break;
+
+        case Fragment: {
+            elements.fragment.end = consumed;
+        } break;
+
+        default: {
+            if (state != Error) {
+                // The input ended in the middle of something.
+                errorReason = (
+                    (state == IpLiteral) ? ValidationError::BadIpLiteral : (
+                        (state == UserInfo) ? ValidationError::BadPort
+                        : ValidationError::BadPercentEncoding
+                    )
+                );
+                state = Error;
+                errorOffset = consumed;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Parser::EndAuthorityAt(size_t offset) {
+    elements.host.begin = hostBegin;
+    if ((state == UserInfoOrPort) || (state == Port)) {
+        if (portOverflow) {
+            return false;
+        }
+        elements.host.end = portColon;
+        elements.hasPort = true;
+        elements.port = (uint16_t)portValue;
+    } else {
+        elements.host.end = offset;
+    }
+    return true;
+}
+
+void Parser::BeginQueryAt(size_t offset) {
+    elements.path.end = offset;
+    elements.hasQuery = true;
+    elements.query.begin = offset + 1;
+}
+
+void Parser::BeginFragmentAt(size_t offset) {
+    if (state == Query) {
+        elements.query.end = offset;
+    } else {
+        elements.path.end = offset;
+    }
+    elements.hasFragment = true;
+    elements.fragment.begin = offset + 1;
+}
+} // namespace Uri
@@ -0,0 +1,379 @@
+#ifndef URI_PARSER_HPP
+#define URI_PARSER_HPP
+
+/**
+ * @file Parser.hpp
+ *
+ * This module declares the Uri::Parser structure, the state machine
+ * which recognizes the URI grammar of RFC 3986
+ * (https://tools.ietf.org/html/rfc3986).
+ */
+
+#include <Uri/UriView.hpp>
+#include <Uri/Validate.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+/**
+ * This holds where each element of a URI was found by the parser,
+ * as offsets from the first character given to the parser.
+ */
+struct Elements {
+    UriView::Range scheme;
+    UriView::Range userInfo;
+    UriView::Range host;
+    UriView::Range path;
+    UriView::Range query;
+    UriView::Range fragment;
+    uint16_t port = 0;
+    bool hasScheme = false;
+    bool hasAuthority = false;
+    bool hasUserInfo = false;
+    bool hasPort = false;
+    bool hasQuery = false;
+    bool hasFragment = false;
+};
+
+/**
+ * This checks, a character at a time, that what's inside the brackets
+ * of an IP-literal host is an IPv6address or an IPvFuture (RFC 3986
+ * section 3.2.2), so that it can be checked however the URI is split
+ * into pieces, without going back over it.
+ */
+struct IpLiteralChecker {
+    // Types
+
+    /**
+     * These are the forms which the IP-literal may turn out to have.
+     */
+    enum Form : uint8_t {
+        // Nothing consumed yet.
+        Unknown,
+
+        // In an IPv6address, before any dotted IPv4address at its end.
+        Ipv6,
+
+        // In the IPv4address which ends an IPv6address.
+        Ipv4,
+
+        // In the version of an IPvFuture, after the "v".
+        FutureVersion,
+
+        // In the address of an IPvFuture, after the ".".
+        FutureAddress,
+    };
+
+    // Properties
+
+    /**
+     * This is the form of IP-literal being consumed.
+     */
+    Form form = Unknown;
+
+    /**
+     * This is the number of 16-bit pieces of an IPv6address
+     * ended by a colon so far.
+     */
+    uint8_t pieces = 0;
+
+    /**
+     * This is the number of consecutive colons just consumed.
+     */
+    uint8_t colons = 0;
+
+    /**
+     * This is the number of digits consumed in the current piece,
+     * octet, or version, or the number of characters of the address
+     * of an IPvFuture, up to its limit.
+     */
+    uint8_t digits = 0;
+
+    /**
+     * This is the number of octets of an IPv4address
+     * ended by a dot so far.
+     */
+    uint8_t octets = 0;
+
+    /**
+     * This flag indicates whether or not the "::" which stands
+     * for one or more pieces of zeros has been consumed.
+     */
+    bool doubleColon = false;
+
+    /**
+     * This flag indicates whether or not the current piece is all
+     * decimal digits without a leading zero, so that it could be
+     * the first octet of an IPv4address.
+     */
+    bool decimal = false;
+
+    /**
+     * This is the decimal value of the current piece or octet,
+     * up to just past the largest an octet can be.
+     */
+    uint16_t value = 0;
+
+    // Methods
+
+    /**
+     * This method consumes the next character inside the brackets.
+     *
+     * @param[in] c
+     *     This is the character to consume, which is one allowed in
+     *     a reg-name, not counting percent-encoded octets, or ":".
+     *
+     * @return
+     *     An indication of whether or not the characters consumed
+     *     so far could be the start of an IP-literal is returned.
+     */
+    bool Consume(char c);
+
+    /**
+     * This method tells the checker that the closing bracket
+     * has been reached.
+     *
+     * @return
+     *     An indication of whether or not the characters consumed
+     *     make up an IPv6address or an IPvFuture is returned.
+     */
+    bool Finish() const;
+};
+
+/**
+ * This is a single-pass, table-driven state machine which recognizes
+ * a URI-reference (RFC 3986 section 4.1), rejecting characters which
+ * are not allowed where they appear, and recording the boundaries of
+ * the elements of the URI as it goes.
+ *
+ * Every character is classified into a category with one table
+ * lookup, and the pair of the current state and that category is
+ * looked up in a transition table to find the next state and any
+ * bookkeeping to do.  No character is ever looked at twice.
+ *
+ * The parser may be given its input in any number of pieces, with
+ * the position of everything it records counted from the first
+ * character of the first piece.
+ */
+struct Parser {
+    // Types
+
+    /**
+     * These are the states of the parser.
+     */
+    enum State : uint8_t {
+        // Nothing consumed yet.
+        Start,
+
+        // Consumed one or more scheme characters, which may turn
+        // out to be either the scheme or the first path segment.
+        SchemeOrSegment,
+
+        // In the first segment of a relative path, where no colon
+        // is allowed (RFC 3986 section 4.2).
+        FirstSegment,
+
+        // Just consumed the colon which ends the scheme.
+        AfterScheme,
+
+        // Consumed a slash at the start of the hierarchical part,
+        // which may be followed by another slash to begin the
+        // authority.
+        PathOrAuthority,
+
+        // At the start of the authority.
+        AuthorityStart,
+
+        // In the authority, before any "@" or ":", where what is
+        // being consumed could be either user info or host.
+        Authority,
+
+        // In the authority, after a ":" followed only by digits, but
+        // before any "@", where what is being consumed could be either
+        // user info or a port.
+        UserInfoOrPort,
+
+        // In the authority, where what is being consumed can only be
+        // user info.
+        UserInfo,
+
+        // At the start of the host, after the user info.
+        HostStart,
+
+        // In the host, after the user info.
+        Host,
+
+        // In the port, after the host.
+        Port,
+
+        // Inside the brackets of an IP-literal host.
+        IpLiteral,
+
+        // Just after the closing bracket of an IP-literal host.
+        AfterIpLiteral,
+
+        // In the path.
+        Path,
+
+        // In the query.
+        Query,
+
+        // In the fragment.
+        Fragment,
+
+        // Consumed the "%" which begins a percent-encoded octet.
+        PercentFirst,
+
+        // Consumed the first hexadecimal digit of a percent-encoded
+        // octet.
+        PercentSecond,
+
+        // Consumed a character which cannot appear where it did.
+        Error,
+
+        NumStates
+    };
+
+    // Properties
+
+    /**
+     * This is the current state of the parser.
+     */
+    State state = Start;
+
+    /**
+     * This is the state to return to after a percent-encoded
+     * octet is consumed.
+     */
+    State percentReturn = Start;
+
+    /**
+     * This is the number of characters consumed so far.
+     */
+    size_t consumed = 0;
+
+    /**
+     * This is where the host begins, once the authority has begun.
+     */
+    size_t hostBegin = 0;
+
+    /**
+     * This is where the colon which could begin the port is,
+     * once one has been found in the authority.
+     */
+    size_t portColon = 0;
+
+    /**
+     * This is the value of the port digits consumed so far.
+     */
+    uint32_t portValue = 0;
+
+    /**
+     * This flag indicates whether or not the port digits consumed so
+     * far are too large to be a port number.
+     */
+    bool portOverflow = false;
+
+    /**
+     * This checks what's inside the brackets of an IP-literal host.
+     */
+    IpLiteralChecker ipLiteral;
+
+    /**
+     * This is where the parser found the character which
+     * made the URI invalid, if it did.
+     */
+    size_t errorOffset = 0;
+
+    /**
+     * This is why the URI is invalid, if the parser found it to be.
+     */
+    ValidationError errorReason = ValidationError::None;
+
+    /**
+     * These are the elements of the URI found so far.
+     */
+    Elements elements;
+
+    // Methods
+
+    /**
+     * This method consumes the next piece of the URI.
+     *
+     * @param[in] data
+     *     This points to the characters to consume.
+     *
+     * @param[in] length
+     *     This is the number of characters to consume.
+     *
+     * @return
+     *     An indication of whether or not the characters
+     *     consumed so far could be the start of a valid URI
+     *     is returned.
+     */
+    bool Consume(const char* data, size_t length);
+
+    /**
+     * This method tells the parser that there is no more input,
+     * completing the element which was being consumed.
+     *
+     * @return
+     *     An indication of whether or not the characters
+     *     consumed make up a valid URI is returned.
+     */
+    bool Finish();
+
+    /**
+     * This is a convenience method which consumes the whole
+     * of a URI and finishes the parse.
+     *
+     * @param[in] data
+     *     This points to the characters of the URI.
+     *
+     * @param[in] length
+     *     This is the number of characters in the URI.
+     *
+     * @return
+     *     An indication of whether or not the characters
+     *     make up a valid URI is returned.
+     */
+    bool Parse(const char* data, size_t length) {
+        return Consume(data, length) && Finish();
+    }
+
+    /**
+     * This method records the end of the authority, and with it
+     * the host and the port, if any.
+     *
+     * @param[in] offset
+     *     This is where the authority ends.
+     *
+     * @return
+     *     An indication of whether or not the port, if any,
+     *     is a valid port number is returned.
+     */
+    bool EndAuthorityAt(size_t offset);
+
+    /**
+     * This method records the end of the path and the
+     * beginning of the query.
+     *
+     * @param[in] offset
+     *     This is where the "?" beginning the query is.
+     */
+    void BeginQueryAt(size_t offset);
+
+    /**
+     * This method records the end of the path or query and the
+     * beginning of the fragment.
+     *
+     * @param[in] offset
+     *     This is where the "#" beginning the fragment is.
+     */
+    void BeginFragmentAt(size_t offset);
+};
+} // namespace Uri
+
+#endif /* URI_PARSER_HPP */
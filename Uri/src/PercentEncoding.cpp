@@ -0,0 +1,321 @@
+/**
+ * @file PercentEncoding.cpp
+ *
+ * This module contains the implementation of the functions which
+ * percent-encode the elements of a URI, and decode their
+ * percent-encoded octets.
+ */
+
+#include <Uri/PercentEncoding.hpp>
+
+#include "BlockFinder.hpp"
+#include "EscapeScan.hpp"
+#include "PercentScan.hpp"
+
+#include <Uri/CharacterClasses.hpp>
+
+#include <string.h>
+
+namespace {
+/**
+ * This is the value of a character which is not a hexadecimal digit,
+ * in the table of the values of hexadecimal digits.
+ */
+constexpr uint8_t NOT_HEX = 0xFF;
+
+/**
+ * This function determines the value of the given character as a
+ * hexadecimal digit.  Use the hexValues table instead, which holds
+ * the result for every character.
+ */
+constexpr uint8_t ComputeHexValue(unsigned int c) {
+    return (uint8_t)(
+        ((c >= '0') && (c <= '9')) ? (c - '0') : (
+            ((c >= 'A') && (c <= 'F')) ? (c - 'A' + 10) : (
+                ((c >= 'a') && (c <= 'f')) ? (c - 'a' + 10) : NOT_HEX
+            )
+        )
+    );
+}
+
+/**
+ * This is the table of the values of hexadecimal digits,
+ * built at compile time.
+ */
+constexpr Uri::CharacterClasses::CharacterTable< uint8_t > hexValues = (
+    Uri::CharacterClasses::MakeCharacterTable(
+        ComputeHexValue,
+        Uri::CharacterClasses::MakeIndexSequence< 256 >()
+    )
+);
+
+/**
+ * These are the uppercase hexadecimal digits, by value.
+ */
+constexpr char hexDigits[] = "0123456789ABCDEF";
+
+/**
+ * This function finds the characters which need to be percent-encoded
+ * in the block of characters at the given position of the given span,
+ * which may be shorter than a whole block at the end of the span.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each character
+ *     of the block which needs to be percent-encoded.
+ */
+uint64_t ScanEscapesAt(
+    const char* data,
+    size_t length,
+    size_t position,
+    const Uri::EncodeSet& encodeSet,
+    uint64_t (*scanEscapes)(const char* data, const uint8_t* lowNibbleBits)
+) {
+    if (length - position >= Uri::ESCAPE_SCAN_BLOCK_SIZE) {
+        return scanEscapes(data + position, encodeSet.lowNibbleBits);
+    } else {
+        return Uri::ScanEscapesPartial(
+            data + position,
+            length - position,
+            encodeSet.lowNibbleBits
+        );
+    }
+}
+
+/**
+ * This finds the "%" characters in a span, a block at a time.
+ */
+class PercentFinder
+    : public Uri::BlockFinder<
+        Uri::BlockScanFn, Uri::PartialBlockScanFn, Uri::PERCENT_SCAN_BLOCK_SIZE
+    >
+{
+public:
+    /**
+     * This constructs a finder for the given span of characters.
+     */
+    PercentFinder(const char* data, size_t length)
+        : BlockFinder(data, length, Uri::GetKernels().scanPercents, Uri::ScanPercentsPartial)
+    {
+    }
+};
+
+/**
+ * This function makes the result of decoding which failed.
+ */
+Uri::DecodeResult Failure(Uri::DecodeError error, size_t offset) {
+    Uri::DecodeResult result;
+    result.error = error;
+    result.errorOffset = offset;
+    return result;
+}
+
+/**
+ * This function turns each "+" in the given characters, which have
+ * already been put in the output, into a space, if DECODE_PLUS_AS_SPACE
+ * is among the given options.
+ */
+void DecodePlusSigns(char* characters, size_t length, unsigned int options) {
+    if ((options & Uri::DECODE_PLUS_AS_SPACE) == 0) {
+        return;
+    }
+    char* const end = characters + length;
+    while ((characters = (char*)memchr(characters, '+', (size_t)(end - characters))) != nullptr) {
+        *characters++ = ' ';
+    }
+}
+
+/**
+ * This function decodes the given characters, beginning with a "%"
+ * found at the given position, with the characters before that
+ * already in place in the output.
+ *
+ * Runs of characters between percent-encoded octets are moved into
+ * place only if decoding has made the output fall behind the input,
+ * so decoding in place costs nothing until the first "%".
+ */
+Uri::DecodeResult DecodeFrom(
+    const char* data,
+    size_t length,
+    char* output,
+    unsigned int options,
+    PercentFinder& percents,
+    size_t percent
+) {
+    size_t read = percent;
+    size_t written = percent;
+    while (percent < length) {
+        if (percent > read) {
+            if ((output != data) || (written != read)) {
+                memmove(output + written, data + read, percent - read);
+            }
+            DecodePlusSigns(output + written, percent - read, options);
+            written += percent - read;
+        }
+        if (length - percent < 3) {
+            return Failure(Uri::DecodeError::BadPercentEncoding, percent);
+        }
+        const auto high = hexValues[data[percent + 1]];
+        const auto low = hexValues[data[percent + 2]];
+        if ((high == NOT_HEX) || (low == NOT_HEX)) {
+            return Failure(Uri::DecodeError::BadPercentEncoding, percent);
+        }
+        const auto decoded = (char)((high << 4) | low);
+        if ((decoded == '\0') && ((options & Uri::DECODE_REJECT_NUL) != 0)) {
+            return Failure(Uri::DecodeError::DecodedNul, percent);
+        }
+        if ((decoded == '/') && ((options & Uri::DECODE_REJECT_SLASH) != 0)) {
+            return Failure(Uri::DecodeError::DecodedSlash, percent);
+        }
+        output[written++] = decoded;
+        read = percent + 3;
+        percent = percents.Next(read);
+    }
+    if (length > read) {
+        if ((output != data) || (written != read)) {
+            memmove(output + written, data + read, length - read);
+        }
+        DecodePlusSigns(output + written, length - read, options);
+    }
+    Uri::DecodeResult result;
+    result.length = written + (length - read);
+    return result;
+}
+}
+
+namespace Uri
+{
+DecodeResult PercentDecode(
+    const char* data,
+    size_t length,
+    char* output,
+    unsigned int options
+) {
+    PercentFinder percents(data, length);
+    const size_t percent = percents.Next(0);
+    if ((percent > 0) && (output != data)) {
+        memcpy(output, data, percent);
+    }
+    DecodePlusSigns(output, percent, options);
+    return DecodeFrom(data, length, output, options, percents, percent);
+}
+
+DecodeResult PercentDecodeInPlace(
+    std::string& buffer,
+    unsigned int options
+) {
+    char* const data = &buffer[0];
+    PercentFinder percents(data, buffer.length());
+    const size_t percent = percents.Next(0);
+    DecodePlusSigns(data, percent, options);
+    const auto result = DecodeFrom(
+        data,
+        buffer.length(),
+        data,
+        options,
+        percents,
+        percent
+    );
+    if (result.IsValid()) {
+        buffer.resize(result.length);
+    }
+    return result;
+}
+
+DecodeResult PercentDecodeView(
+    StringView encoded,
+    std::string& scratch,
+    StringView& decoded,
+    unsigned int options
+) {
+    PercentFinder percents(encoded.data(), encoded.size());
+    const size_t percent = percents.Next(0);
+    if (
+        (percent == encoded.size())
+        && (
+            ((options & DECODE_PLUS_AS_SPACE) == 0)
+            || (memchr(encoded.data(), '+', encoded.size()) == nullptr)
+        )
+    ) {
+        decoded = encoded;
+        DecodeResult result;
+        result.length = encoded.size();
+        return result;
+    }
+    scratch.resize(encoded.size());
+    memcpy(&scratch[0], encoded.data(), percent);
+    DecodePlusSigns(&scratch[0], percent, options);
+    const auto result = DecodeFrom(
+        encoded.data(),
+        encoded.size(),
+        &scratch[0],
+        options,
+        percents,
+        percent
+    );
+    if (result.IsValid()) {
+        scratch.resize(result.length);
+        decoded = StringView(scratch.data(), scratch.size());
+    }
+    return result;
+}
+
+size_t PercentEncodedLength(
+    const char* data,
+    size_t length,
+    const EncodeSet& encodeSet
+) {
+    const auto scanEscapes = GetKernels().scanEscapes;
+    size_t encodedLength = length;
+    for (size_t position = 0; position < length; position += ESCAPE_SCAN_BLOCK_SIZE) {
+        const auto mask = ScanEscapesAt(data, length, position, encodeSet, scanEscapes);
+        encodedLength += 2 * CountSetBits(mask);
+    }
+    return encodedLength;
+}
+
+size_t PercentEncode(
+    const char* data,
+    size_t length,
+    const EncodeSet& encodeSet,
+    char* output
+) {
+    const auto scanEscapes = GetKernels().scanEscapes;
+    size_t read = 0;
+    size_t written = 0;
+    for (size_t position = 0; position < length; position += ESCAPE_SCAN_BLOCK_SIZE) {
+        auto mask = ScanEscapesAt(data, length, position, encodeSet, scanEscapes);
+        while (mask != 0) {
+            const size_t escape = position + LowestSetBit(mask);
+            mask &= mask - 1;
+            if (escape > read) {
+                memcpy(output + written, data + read, escape - read);
+                written += escape - read;
+            }
+            const auto c = (unsigned char)data[escape];
+            output[written++] = '%';
+            output[written++] = hexDigits[c >> 4];
+            output[written++] = hexDigits[c & 0x0F];
+            read = escape + 1;
+        }
+    }
+    if (length > read) {
+        memcpy(output + written, data + read, length - read);
+        written += length - read;
+    }
+    return written;
+}
+
+std::string PercentEncode(
+    StringView decoded,
+    const EncodeSet& encodeSet
+) {
+    std::string encoded(
+        PercentEncodedLength(decoded.data(), decoded.size(), encodeSet),
+        '\0'
+    );
+    if (!encoded.empty()) {
+        (void)PercentEncode(decoded.data(), decoded.size(), encodeSet, &encoded[0]);
+    }
+    return encoded;
+}
+} // namespace Uri
@@ -0,0 +1,89 @@
+/**
+ * @file PercentScan.cpp
+ *
+ * This module contains the implementation of the functions which find
+ * the "%" characters beginning percent-encoded octets many characters
+ * at a time.
+ */
+
+#include "PercentScan.hpp"
+
+#if defined(URI_X86)
+#include <immintrin.h>
+#endif
+
+namespace {
+/**
+ * This function searches the given characters one at a time.
+ */
+uint64_t ScanCharacters(const char* data, size_t length) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == '%') {
+            mask |= ((uint64_t)1 << i);
+        }
+    }
+    return mask;
+}
+
+#if defined(URI_X86)
+/**
+ * This function searches 16 characters at once.
+ */
+URI_TARGET("sse2")
+uint32_t ScanPercents16(const char* data) {
+    const __m128i characters = _mm_loadu_si128((const __m128i*)data);
+    return (uint32_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(characters, _mm_set1_epi8('%'))
+    );
+}
+
+/**
+ * This function searches 32 characters at once.
+ */
+URI_TARGET("avx2")
+uint32_t ScanPercents32(const char* data) {
+    const __m256i characters = _mm256_loadu_si256((const __m256i*)data);
+    return (uint32_t)_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('%'))
+    );
+}
+#endif
+}
+
+namespace Uri
+{
+uint64_t ScanPercentsScalar(const char* data) {
+    return ScanCharacters(data, PERCENT_SCAN_BLOCK_SIZE);
+}
+
+#if defined(URI_X86)
+URI_TARGET("sse2")
+uint64_t ScanPercentsSse2(const char* data) {
+    return (
+        (uint64_t)ScanPercents16(data)
+        | ((uint64_t)ScanPercents16(data + 16) << 16)
+        | ((uint64_t)ScanPercents16(data + 32) << 32)
+        | ((uint64_t)ScanPercents16(data + 48) << 48)
+    );
+}
+
+URI_TARGET("avx2")
+uint64_t ScanPercentsAvx2(const char* data) {
+    return (
+        (uint64_t)ScanPercents32(data)
+        | ((uint64_t)ScanPercents32(data + 32) << 32)
+    );
+}
+
+URI_TARGET("avx512f,avx512bw")
+uint64_t ScanPercentsAvx512(const char* data) {
+    const __m512i characters = _mm512_loadu_si512((const void*)data);
+    return (uint64_t)_mm512_cmpeq_epi8_mask(characters, _mm512_set1_epi8('%'));
+}
+#endif
+
+uint64_t ScanPercentsPartial(const char* data, size_t length) {
+    return ScanCharacters(data, length);
+}
+} // namespace Uri
@@ -0,0 +1,73 @@
+#ifndef URI_PERCENT_SCAN_HPP
+#define URI_PERCENT_SCAN_HPP
+
+/**
+ * @file PercentScan.hpp
+ *
+ * This module declares the functions which find the "%" characters
+ * beginning percent-encoded octets many characters at a time.
+ */
+
+#include "DelimiterScan.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+/**
+ * This is the number of characters searched at once
+ * by the ScanPercents function.
+ */
+constexpr size_t PERCENT_SCAN_BLOCK_SIZE = 64;
+
+/**
+ * These functions find the "%" characters in a block of characters.
+ *
+ * There is one function for each kernel set; use ScanPercents
+ * to call the one currently in use.
+ *
+ * @param[in] data
+ *     This points to the block of PERCENT_SCAN_BLOCK_SIZE
+ *     characters to search.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each "%" in the
+ *     block, with the least significant bit corresponding to the
+ *     first character.
+ */
+uint64_t ScanPercentsScalar(const char* data);
+#if defined(URI_X86)
+uint64_t ScanPercentsSse2(const char* data);
+uint64_t ScanPercentsAvx2(const char* data);
+uint64_t ScanPercentsAvx512(const char* data);
+#endif
+
+/**
+ * This function searches a block of characters with the
+ * kernel currently in use (see ScanPercentsScalar).
+ */
+inline uint64_t ScanPercents(const char* data) {
+    return GetKernels().scanPercents(data);
+}
+
+/**
+ * This function is the same as ScanPercents, except that it
+ * searches only the given number of characters, which may be
+ * fewer than a whole block.
+ *
+ * @param[in] data
+ *     This points to the characters to search.
+ *
+ * @param[in] length
+ *     This is the number of characters to search, which must
+ *     not exceed PERCENT_SCAN_BLOCK_SIZE.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each "%".
+ *     Bits past the given number of characters are clear.
+ */
+uint64_t ScanPercentsPartial(const char* data, size_t length);
+} // namespace Uri
+
+#endif /* URI_PERCENT_SCAN_HPP */
@@ -0,0 +1,118 @@
+/**
+ * @file QueryIndex.cpp
+ *
+ * This module contains the implementation of the
+ * Uri::QueryIndex class.
+ */
+
+#include "QueryIndex.hpp"
+
+#include "Hasher.hpp"
+
+#include <Uri/QueryParameters.hpp>
+
+#include <string.h>
+
+namespace Uri
+{
+constexpr uint32_t QueryIndex::NONE;
+
+QueryIndex::QueryIndex(StringView query) {
+    const char* const base = query.data();
+    parameters_.reserve(query.size() / 16 + 1);
+    for (const auto& parameter: QueryParameters(query)) {
+        Parameter entry;
+        entry.keyBegin = (uint32_t)(parameter.key.data() - base);
+        entry.keyLength = (uint32_t)parameter.key.size();
+        entry.valueBegin = (uint32_t)(parameter.value.data() - base);
+        entry.valueLength = (uint32_t)parameter.value.size();
+        entry.hash = HashKey(parameter.key);
+        entry.next = NONE;
+        entry.last = NONE;
+        parameters_.push_back(entry);
+    }
+
+    // The table is kept at most half full, so that probing
+    // for a key not in it stops quickly.
+    size_t numSlots = 4;
+    while (numSlots < parameters_.size() * 2) {
+        numSlots *= 2;
+    }
+    slots_.assign(numSlots, NONE);
+    const size_t slotMask = numSlots - 1;
+    for (uint32_t i = 0; i < (uint32_t)parameters_.size(); ++i) {
+        auto& entry = parameters_[i];
+        for (size_t slot = entry.hash & slotMask;; slot = (slot + 1) & slotMask) {
+            const uint32_t first = slots_[slot];
+            if (first == NONE) {
+                slots_[slot] = i;
+                entry.last = i;
+                break;
+            }
+            auto& firstEntry = parameters_[first];
+            if (
+                (firstEntry.hash == entry.hash)
+                && (firstEntry.keyLength == entry.keyLength)
+                && (memcmp(base + firstEntry.keyBegin, base + entry.keyBegin, entry.keyLength) == 0)
+            ) {
+                parameters_[firstEntry.last].next = i;
+                firstEntry.last = i;
+                break;
+            }
+        }
+    }
+}
+
+uint32_t QueryIndex::Find(const char* query, StringView key) const {
+    const uint32_t hash = HashKey(key);
+    const size_t slotMask = slots_.size() - 1;
+    for (size_t slot = hash & slotMask;; slot = (slot + 1) & slotMask) {
+        const uint32_t first = slots_[slot];
+        if (first == NONE) {
+            return NONE;
+        }
+        const auto& entry = parameters_[first];
+        if (
+            (entry.hash == hash)
+            && (entry.keyLength == key.size())
+            && (memcmp(query + entry.keyBegin, key.data(), key.size()) == 0)
+        ) {
+            return first;
+        }
+    }
+}
+
+uint32_t QueryIndex::HashKey(StringView key) {
+    // Every character of a key goes into its hash, eight at a time,
+    // with the last eight read with a load which may overlap the one
+    // before, since queries come from anywhere, and keys which differ
+    // only in the middle mustn't all land on the same probe chain.
+    const char* data = key.data();
+    size_t length = key.size();
+    uint64_t hash = HASHER_CONSTANTS[0] ^ length;
+    uint64_t last = 0;
+    if (length >= 8) {
+        while (length > 8) {
+            uint64_t word;
+            memcpy(&word, data, 8);
+            hash = FoldedMultiply(hash ^ word, HASHER_CONSTANTS[1]);
+            data += 8;
+            length -= 8;
+        }
+        memcpy(&last, data + length - 8, 8);
+    } else if (length >= 4) {
+        uint32_t head32, tail32;
+        memcpy(&head32, data, 4);
+        memcpy(&tail32, data + length - 4, 4);
+        last = ((uint64_t)head32 << 32) | tail32;
+    } else if (length > 0) {
+        last = (
+            ((uint64_t)(unsigned char)data[0] << 16)
+            | ((uint64_t)(unsigned char)data[length / 2] << 8)
+            | (uint64_t)(unsigned char)data[length - 1]
+        );
+    }
+    hash = FoldedMultiply(hash ^ last, HASHER_CONSTANTS[2]);
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+} // namespace Uri
@@ -0,0 +1,239 @@
+#ifndef URI_QUERY_INDEX_HPP
+#define URI_QUERY_INDEX_HPP
+
+/**
+ * @file QueryIndex.hpp
+ *
+ * This module declares the Uri::QueryIndex class, which finds the
+ * parameters of a query by key without searching the whole query,
+ * and the Uri::LazyQueryIndex class, which builds one only when
+ * it's first needed.
+ */
+
+#include <Uri/StringView.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Uri
+{
+/**
+ * This is the shortest query, in characters, for which an index is
+ * built to look up its parameters.  Shorter queries are searched from
+ * the beginning on every lookup instead, which is faster for them
+ * than building an index.
+ *
+ * The UriBenchmarks QueryLookup benchmark measures where the two
+ * cross over, for four lookups in a fresh URI: with the index always
+ * built, it first wins at around four parameters, or 50 characters.
+ * This is set a little above that, since searching wins for longer
+ * when there are fewer lookups.
+ */
+constexpr size_t QUERY_INDEX_MIN_LENGTH = 64;
+
+/**
+ * This is an open-addressing hash table of the keys of the parameters
+ * of a query, which locates each parameter by its offsets in the
+ * query, so that it doesn't matter where the query itself is kept.
+ *
+ * Parameters with the same key are chained together in the order
+ * they appear in the query.
+ */
+class QueryIndex {
+public:
+    /**
+     * This is the number given in place of a parameter
+     * where there is none.
+     */
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    /**
+     * This builds the index of the parameters of the given query.
+     *
+     * @param[in] query
+     *     This is the query, without the leading question mark,
+     *     which must be shorter than 4 GiB.
+     */
+    explicit QueryIndex(StringView query);
+
+    /**
+     * This method finds the first parameter with the given key.
+     *
+     * @param[in] query
+     *     This points to the characters of the query
+     *     which was indexed, wherever it is now.
+     *
+     * @param[in] key
+     *     This is the key to find, as it's written in the query.
+     *
+     * @return
+     *     The number of the parameter is returned, or NONE
+     *     if no parameter has the given key.
+     */
+    uint32_t Find(const char* query, StringView key) const;
+
+    /**
+     * This method returns the number of the next parameter with
+     * the same key as the given one, or NONE if there are no more.
+     */
+    uint32_t Next(uint32_t parameter) const {
+        return parameters_[parameter].next;
+    }
+
+    /**
+     * This method returns the value of the given parameter.
+     *
+     * @param[in] query
+     *     This points to the characters of the query
+     *     which was indexed, wherever it is now.
+     *
+     * @param[in] parameter
+     *     This is the number of the parameter.
+     */
+    StringView GetValue(const char* query, uint32_t parameter) const {
+        const auto& entry = parameters_[parameter];
+        return StringView(query + entry.valueBegin, entry.valueLength);
+    }
+
+private:
+    /**
+     * This is where one parameter of the query is.
+     */
+    struct Parameter {
+        uint32_t keyBegin;
+        uint32_t keyLength;
+        uint32_t valueBegin;
+        uint32_t valueLength;
+
+        /**
+         * This is the hash of the key, kept to skip comparing
+         * keys which can't be the same.
+         */
+        uint32_t hash;
+
+        /**
+         * This is the number of the next parameter with
+         * the same key, or NONE if there are no more.
+         */
+        uint32_t next;
+
+        /**
+         * This is the number of the last parameter with the same key,
+         * if this is the first, so that more can be chained after it.
+         */
+        uint32_t last;
+    };
+
+    /**
+     * This method returns the hash of the given key.
+     */
+    static uint32_t HashKey(StringView key);
+
+    /**
+     * This holds where the parameters are, in the order they
+     * appear in the query.
+     */
+    std::vector< Parameter > parameters_;
+
+    /**
+     * This is the hash table, whose size is a power of two, holding
+     * the number of the first parameter with each key, or NONE in
+     * slots which are empty.
+     */
+    std::vector< uint32_t > slots_;
+};
+
+/**
+ * This holds the index of the parameters of a query, which is built
+ * the first time it's needed, and thrown away whenever the query
+ * may have changed.
+ *
+ * Getting the index is safe from more than one thread at once: each
+ * thread which finds no index builds one and publishes it atomically,
+ * and any thread which loses the race to publish throws its own away
+ * and uses the one which won.  Resetting it isn't, since it's done only
+ * when the query changes.
+ *
+ * A copy starts out without an index, and builds its own if it's
+ * needed, since copying the index costs about as much as building it.
+ * Moving it takes the index along, since it locates the parameters by
+ * their offsets in the query, not by where the query is kept.
+ */
+class LazyQueryIndex {
+public:
+    LazyQueryIndex() = default;
+
+    ~LazyQueryIndex() noexcept {
+        Reset();
+    }
+
+    LazyQueryIndex(LazyQueryIndex&& other) noexcept
+        : index_(other.index_.exchange(nullptr, std::memory_order_relaxed))
+    {
+    }
+
+    LazyQueryIndex& operator=(LazyQueryIndex&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            index_.store(
+                other.index_.exchange(nullptr, std::memory_order_relaxed),
+                std::memory_order_relaxed
+            );
+        }
+        return *this;
+    }
+
+    LazyQueryIndex(const LazyQueryIndex&) {
+    }
+
+    LazyQueryIndex& operator=(const LazyQueryIndex&) {
+        Reset();
+        return *this;
+    }
+
+    /**
+     * This method returns the index of the given query, building it
+     * if it hasn't been built yet.  The query must be the same one
+     * every time, until Reset is called.
+     *
+     * @param[in] query
+     *     This is the query, without the leading question mark.
+     *
+     * @return
+     *     The index is returned, or null if the query is too short
+     *     to be worth indexing.
+     */
+    const QueryIndex* Get(StringView query) const {
+        const QueryIndex* index = index_.load(std::memory_order_acquire);
+        if (index || (query.size() < QUERY_INDEX_MIN_LENGTH)) {
+            return index;
+        }
+        std::unique_ptr< QueryIndex > built(new QueryIndex(query));
+        if (index_.compare_exchange_strong(
+            index, built.get(),
+            std::memory_order_acq_rel, std::memory_order_acquire
+        )) {
+            return built.release();
+        }
+        return index;
+    }
+
+    /**
+     * This method throws away the index, if it's been built.
+     */
+    void Reset() {
+        delete index_.exchange(nullptr, std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * This is the index, or null if it hasn't been built.
+     */
+    mutable std::atomic< const QueryIndex* > index_{nullptr};
+};
+} // namespace Uri
+
+#endif /* URI_QUERY_INDEX_HPP */
@@ -0,0 +1,70 @@
+/**
+ * @file QueryParameters.cpp
+ *
+ * This module contains the implementation of the
+ * Uri::QueryParameters class.
+ */
+
+#include <Uri/QueryParameters.hpp>
+
+#include "BlockFinder.hpp"
+#include "QueryScan.hpp"
+
+namespace
+{
+/**
+ * This scans a block of a query for separators with the kernel in use,
+ * looking the kernel up only when a block is actually scanned.
+ */
+struct QuerySeparatorScan {
+    uint64_t operator()(const char* data) const {
+        return Uri::ScanQuerySeparators(data);
+    }
+};
+}
+
+namespace Uri
+{
+void QueryParameters::Iterator::Advance() {
+    while (next_ < length_) {
+        // A parameter ends at the next "&", and its key ends at the
+        // first "=" before that, if there is one.  Any other "="
+        // is part of the value.
+        const size_t begin = next_;
+        size_t equals = length_;
+        size_t end = FindSeparator(begin);
+        while ((end < length_) && (query_[end] == '=')) {
+            if (equals == length_) {
+                equals = end;
+            }
+            end = FindSeparator(end + 1);
+        }
+        next_ = end + 1;
+        if (end > begin) {
+            position_ = begin;
+            if (equals < end) {
+                parameter_.key = StringView(query_ + begin, equals - begin);
+                parameter_.value = StringView(query_ + equals + 1, end - equals - 1);
+                parameter_.hasValue = true;
+            } else {
+                parameter_.key = StringView(query_ + begin, end - begin);
+                parameter_.value = StringView(query_ + end, 0);
+                parameter_.hasValue = false;
+            }
+            return;
+        }
+    }
+    position_ = length_ + 1;
+    parameter_ = QueryParameter();
+}
+
+size_t QueryParameters::Iterator::FindSeparator(size_t position) {
+    return BlockFinder<
+        QuerySeparatorScan, PartialBlockScanFn, QUERY_SCAN_BLOCK_SIZE
+    >::Find(
+        query_, length_, position,
+        QuerySeparatorScan(), ScanQuerySeparatorsPartial,
+        blockBegin_, blockEnd_, mask_
+    );
+}
+} // namespace Uri
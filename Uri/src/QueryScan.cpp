@@ -0,0 +1,98 @@
+/**
+ * @file QueryScan.cpp
+ *
+ * This module contains the implementation of the functions which find
+ * the "&" and "=" characters separating the parameters of a query
+ * many characters at a time.
+ */
+
+#include "QueryScan.hpp"
+
+#if defined(URI_X86)
+#include <immintrin.h>
+#endif
+
+namespace {
+/**
+ * This function searches the given characters one at a time.
+ */
+uint64_t ScanCharacters(const char* data, size_t length) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if ((data[i] == '&') || (data[i] == '=')) {
+            mask |= ((uint64_t)1 << i);
+        }
+    }
+    return mask;
+}
+
+#if defined(URI_X86)
+/**
+ * This function searches 16 characters at once.
+ */
+URI_TARGET("sse2")
+uint32_t ScanQuerySeparators16(const char* data) {
+    const __m128i characters = _mm_loadu_si128((const __m128i*)data);
+    return (uint32_t)_mm_movemask_epi8(
+        _mm_or_si128(
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8('&')),
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8('='))
+        )
+    );
+}
+
+/**
+ * This function searches 32 characters at once.
+ */
+URI_TARGET("avx2")
+uint32_t ScanQuerySeparators32(const char* data) {
+    const __m256i characters = _mm256_loadu_si256((const __m256i*)data);
+    return (uint32_t)_mm256_movemask_epi8(
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('&')),
+            _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('='))
+        )
+    );
+}
+#endif
+}
+
+namespace Uri
+{
+uint64_t ScanQuerySeparatorsScalar(const char* data) {
+    return ScanCharacters(data, QUERY_SCAN_BLOCK_SIZE);
+}
+
+#if defined(URI_X86)
+URI_TARGET("sse2")
+uint64_t ScanQuerySeparatorsSse2(const char* data) {
+    return (
+        (uint64_t)ScanQuerySeparators16(data)
+        | ((uint64_t)ScanQuerySeparators16(data + 16) << 16)
+        | ((uint64_t)ScanQuerySeparators16(data + 32) << 32)
+        | ((uint64_t)ScanQuerySeparators16(data + 48) << 48)
+    );
+}
+
+URI_TARGET("avx2")
+uint64_t ScanQuerySeparatorsAvx2(const char* data) {
+    return (
+        (uint64_t)ScanQuerySeparators32(data)
+        | ((uint64_t)ScanQuerySeparators32(data + 32) << 32)
+    );
+}
+
+URI_TARGET("avx512f,avx512bw")
+uint64_t ScanQuerySeparatorsAvx512(const char* data) {
+    const __m512i characters = _mm512_loadu_si512((const void*)data);
+    return (
+        (uint64_t)_mm512_cmpeq_epi8_mask(characters, _mm512_set1_epi8('&'))
+        | (uint64_t)_mm512_cmpeq_epi8_mask(characters, _mm512_set1_epi8('='))
+    );
+}
+#endif
+
+uint64_t ScanQuerySeparatorsPartial(const char* data, size_t length) {
+    return ScanCharacters(data, length);
+}
+} // namespace Uri
@@ -0,0 +1,75 @@
+#ifndef URI_QUERY_SCAN_HPP
+#define URI_QUERY_SCAN_HPP
+
+/**
+ * @file QueryScan.hpp
+ *
+ * This module declares the functions which find the "&" and "="
+ * characters separating the parameters of a query, and their keys
+ * from their values, many characters at a time.
+ */
+
+#include "DelimiterScan.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Uri
+{
+/**
+ * This is the number of characters searched at once
+ * by the ScanQuerySeparators function.
+ */
+constexpr size_t QUERY_SCAN_BLOCK_SIZE = 64;
+
+/**
+ * These functions find the "&" and "=" characters in a block
+ * of characters.
+ *
+ * There is one function for each kernel set; use ScanQuerySeparators
+ * to call the one currently in use.
+ *
+ * @param[in] data
+ *     This points to the block of QUERY_SCAN_BLOCK_SIZE
+ *     characters to search.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each "&" or "="
+ *     in the block, with the least significant bit corresponding
+ *     to the first character.
+ */
+uint64_t ScanQuerySeparatorsScalar(const char* data);
+#if defined(URI_X86)
+uint64_t ScanQuerySeparatorsSse2(const char* data);
+uint64_t ScanQuerySeparatorsAvx2(const char* data);
+uint64_t ScanQuerySeparatorsAvx512(const char* data);
+#endif
+
+/**
+ * This function searches a block of characters with the
+ * kernel currently in use (see ScanQuerySeparatorsScalar).
+ */
+inline uint64_t ScanQuerySeparators(const char* data) {
+    return GetKernels().scanQuerySeparators(data);
+}
+
+/**
+ * This function is the same as ScanQuerySeparators, except that it
+ * searches only the given number of characters, which may be
+ * fewer than a whole block.
+ *
+ * @param[in] data
+ *     This points to the characters to search.
+ *
+ * @param[in] length
+ *     This is the number of characters to search, which must
+ *     not exceed QUERY_SCAN_BLOCK_SIZE.
+ *
+ * @return
+ *     A mask is returned, which has a bit set for each "&" or "=".
+ *     Bits past the given number of characters are clear.
+ */
+uint64_t ScanQuerySeparatorsPartial(const char* data, size_t length);
+} // namespace Uri
+
+#endif /* URI_QUERY_SCAN_HPP */
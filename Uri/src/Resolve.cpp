@@ -0,0 +1,332 @@
+/**
+ * @file Resolve.cpp
+ *
+ * This module contains the implementation of the functions which
+ * resolve a URI reference against a base URI.
+ */
+
+#include "Resolve.hpp"
+
+#include <string.h>
+
+namespace {
+/**
+ * This function returns an indication of whether or not the given
+ * characters begin with the given prefix.
+ */
+bool BeginsWith(const char* data, size_t length, const char* prefix, size_t prefixLength) {
+    return (
+        (length >= prefixLength)
+        && (memcmp(data, prefix, prefixLength) == 0)
+    );
+}
+
+/**
+ * This function returns an indication of whether or not the given
+ * characters are exactly the given string.
+ */
+bool Equals(const char* data, size_t length, const char* other, size_t otherLength) {
+    return (
+        (length == otherLength)
+        && (memcmp(data, other, otherLength) == 0)
+    );
+}
+
+/**
+ * This function takes the last segment, and the slash before it, if
+ * any, back out of a path being written.
+ *
+ * @param[in] output
+ *     This points to the path being written.
+ *
+ * @param[in] written
+ *     This is the number of characters of the path written so far.
+ *
+ * @return
+ *     The number of characters of the path left is returned.
+ */
+size_t RemoveLastSegment(const char* output, size_t written) {
+    while (written > 0) {
+        if (output[--written] == '/') {
+            break;
+        }
+    }
+    return written;
+}
+
+/**
+ * This function copies the given range of characters to the given
+ * position of the output.
+ *
+ * @return
+ *     The position just after the characters copied is returned.
+ */
+size_t AppendRange(
+    const char* source,
+    const Uri::UriView::Range& range,
+    char* output,
+    size_t position
+) {
+    memcpy(output + position, source + range.begin, range.Length());
+    return position + range.Length();
+}
+
+/**
+ * This function copies the scheme of the given URI, and the colon
+ * which ends it, to the beginning of the output.
+ *
+ * @return
+ *     The position just after the characters copied is returned.
+ */
+size_t AppendScheme(
+    const char* source,
+    const Uri::Elements& from,
+    char* output,
+    Uri::Elements& target
+) {
+    target.hasScheme = true;
+    target.scheme = from.scheme;
+    memcpy(output, source, from.scheme.end + 1);
+    return from.scheme.end + 1;
+}
+
+/**
+ * This function copies the authority of the given URI, with the two
+ * slashes which begin it, to the given position of the output.
+ *
+ * @return
+ *     The position just after the characters copied is returned.
+ */
+size_t AppendAuthority(
+    const char* source,
+    const Uri::Elements& from,
+    char* output,
+    size_t position,
+    Uri::Elements& target
+) {
+    output[position++] = '/';
+    output[position++] = '/';
+    const size_t begin = from.hasUserInfo ? from.userInfo.begin : from.host.begin;
+    const size_t end = from.path.begin;
+    memcpy(output + position, source + begin, end - begin);
+    target.hasAuthority = true;
+    target.hasUserInfo = from.hasUserInfo;
+    target.host.begin = from.host.begin - begin + position;
+    target.host.end = from.host.end - begin + position;
+    if (from.hasUserInfo) {
+        target.userInfo.begin = from.userInfo.begin - begin + position;
+        target.userInfo.end = from.userInfo.end - begin + position;
+    } else {
+        target.userInfo.begin = target.userInfo.end = target.host.begin;
+    }
+    target.hasPort = from.hasPort;
+    target.port = from.port;
+    return position + (end - begin);
+}
+
+/**
+ * This function copies the path of the given URI to the given
+ * position of the output, removing its dot segments on the way.
+ *
+ * @return
+ *     The position just after the characters copied is returned.
+ */
+size_t AppendPathWithoutDotSegments(
+    const char* source,
+    const Uri::Elements& from,
+    char* output,
+    size_t position
+) {
+    return position + Uri::RemoveDotSegments(
+        source + from.path.begin,
+        from.path.Length(),
+        output + position
+    );
+}
+
+/**
+ * This function merges the path of the reference with the path of
+ * the base (RFC 3986 section 5.2.3) at the given position of the
+ * output, and then removes the dot segments of the result in place.
+ *
+ * @return
+ *     The position just after the path is returned.
+ */
+size_t AppendMergedPath(
+    const char* base,
+    const Uri::Elements& baseElements,
+    const char* reference,
+    const Uri::Elements& referenceElements,
+    char* output,
+    size_t position
+) {
+    const size_t pathBegin = position;
+    if (baseElements.hasAuthority && (baseElements.path.Length() == 0)) {
+        output[position++] = '/';
+    } else {
+        auto directory = baseElements.path;
+        while (
+            (directory.end > directory.begin)
+            && (base[directory.end - 1] != '/')
+        ) {
+            --directory.end;
+        }
+        position = AppendRange(base, directory, output, position);
+    }
+    position = AppendRange(reference, referenceElements.path, output, position);
+    return pathBegin + Uri::RemoveDotSegments(
+        output + pathBegin,
+        position - pathBegin,
+        output + pathBegin
+    );
+}
+}
+
+namespace Uri
+{
+bool HasDotSegments(const char* path, size_t length) {
+    const char* const end = path + length;
+    const char* dot = path;
+    while ((dot = (const char*)memchr(dot, '.', (size_t)(end - dot))) != nullptr) {
+        if ((dot == path) || (dot[-1] == '/')) {
+            const char* segmentEnd = dot + 1;
+            if ((segmentEnd < end) && (*segmentEnd == '.')) {
+                ++segmentEnd;
+            }
+            if ((segmentEnd == end) || (*segmentEnd == '/')) {
+                return true;
+            }
+        }
+        ++dot;
+    }
+    return false;
+}
+
+size_t RemoveDotSegments(const char* input, size_t length, char* output) {
+    // Most paths have no dot segments at all, and are left as they are.
+    if (!HasDotSegments(input, length)) {
+        if (output != input) {
+            memcpy(output, input, length);
+        }
+        return length;
+    }
+    size_t read = 0;
+    size_t written = 0;
+    while (read < length) {
+        const char* const rest = input + read;
+        const size_t restLength = length - read;
+        if (BeginsWith(rest, restLength, "../", 3)) {
+            read += 3;
+        } else if (BeginsWith(rest, restLength, "./", 2)) {
+            read += 2;
+        } else if (BeginsWith(rest, restLength, "/./", 3)) {
+            read += 2;
+        } else if (Equals(rest, restLength, "/.", 2)) {
+            output[written++] = '/';
+            break;
+        } else if (BeginsWith(rest, restLength, "/../", 4)) {
+            read += 3;
+            written = RemoveLastSegment(output, written);
+        } else if (Equals(rest, restLength, "/..", 3)) {
+            written = RemoveLastSegment(output, written);
+            output[written++] = '/';
+            break;
+        } else if (
+            Equals(rest, restLength, ".", 1)
+            || Equals(rest, restLength, "..", 2)
+        ) {
+            break;
+        } else {
+            // Move the first segment, with the slash before it, if any,
+            // to the output.  Nothing is ever written ahead of what's
+            // been read, so this is safe to do in place.
+            const size_t segmentBegin = (rest[0] == '/') ? 1 : 0;
+            const auto slash = (const char*)memchr(
+                rest + segmentBegin,
+                '/',
+                restLength - segmentBegin
+            );
+            const size_t segmentLength = (
+                (slash == nullptr) ? restLength : (size_t)(slash - rest)
+            );
+            if (output + written != rest) {
+                memmove(output + written, rest, segmentLength);
+            }
+            written += segmentLength;
+            read += segmentLength;
+        }
+    }
+    return written;
+}
+
+Elements ResolveReference(
+    const char* base,
+    const Elements& baseElements,
+    const char* reference,
+    const Elements& referenceElements,
+    char* output
+) {
+    Elements target;
+    size_t position = 0;
+    const Elements* query = &referenceElements;
+    const char* querySource = reference;
+    if (referenceElements.hasScheme) {
+        position = AppendScheme(reference, referenceElements, output, target);
+        if (referenceElements.hasAuthority) {
+            position = AppendAuthority(reference, referenceElements, output, position, target);
+        }
+        target.path.begin = position;
+        position = AppendPathWithoutDotSegments(reference, referenceElements, output, position);
+    } else {
+        if (baseElements.hasScheme) {
+            position = AppendScheme(base, baseElements, output, target);
+        }
+        if (referenceElements.hasAuthority) {
+            position = AppendAuthority(reference, referenceElements, output, position, target);
+            target.path.begin = position;
+            position = AppendPathWithoutDotSegments(reference, referenceElements, output, position);
+        } else {
+            if (baseElements.hasAuthority) {
+                position = AppendAuthority(base, baseElements, output, position, target);
+            }
+            target.path.begin = position;
+            if (referenceElements.path.Length() == 0) {
+                position = AppendRange(base, baseElements.path, output, position);
+                if (!referenceElements.hasQuery) {
+                    query = &baseElements;
+                    querySource = base;
+                }
+            } else if (reference[referenceElements.path.begin] == '/') {
+                position = AppendPathWithoutDotSegments(reference, referenceElements, output, position);
+            } else {
+                position = AppendMergedPath(
+                    base,
+                    baseElements,
+                    reference,
+                    referenceElements,
+                    output,
+                    position
+                );
+            }
+        }
+    }
+    target.path.end = position;
+    if (query->hasQuery) {
+        output[position++] = '?';
+        target.hasQuery = true;
+        target.query.begin = position;
+        position = AppendRange(querySource, query->query, output, position);
+        target.query.end = position;
+    }
+    if (referenceElements.hasFragment) {
+        output[position++] = '#';
+        target.hasFragment = true;
+        target.fragment.begin = position;
+        position = AppendRange(reference, referenceElements.fragment, output, position);
+    } else {
+        target.fragment.begin = position;
+    }
+    target.fragment.end = position;
+    return target;
+}
+} // namespace Uri
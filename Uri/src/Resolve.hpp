@@ -0,0 +1,110 @@
+#ifndef URI_RESOLVE_HPP
+#define URI_RESOLVE_HPP
+
+/**
+ * @file Resolve.hpp
+ *
+ * This module declares the functions which resolve a URI reference
+ * against a base URI, as described in RFC 3986 section 5.2.
+ */
+
+#include "Parser.hpp"
+
+#include <stddef.h>
+
+namespace Uri
+{
+/**
+ * This function returns an indication of whether or not the given
+ * path has any "." or ".." segments in it, without changing it.
+ * Finding a "." in a path is quick, and since nearly every "." in
+ * a path is part of a longer segment, such as a file name, only
+ * those found are looked at closely.
+ *
+ * @param[in] path
+ *     This points to the characters of the path.
+ *
+ * @param[in] length
+ *     This is the number of characters in the path.
+ *
+ * @return
+ *     An indication of whether or not the path has any
+ *     dot segments is returned.
+ */
+bool HasDotSegments(const char* path, size_t length);
+
+/**
+ * This function removes the "." and ".." segments from the given path,
+ * as described in RFC 3986 section 5.2.4, copying what's left to the
+ * given output.
+ *
+ * The characters are read strictly ahead of where they're written,
+ * and segments which a later ".." takes back out are simply written
+ * over, so the output may be the same as the input, to remove the
+ * segments in place.
+ *
+ * @param[in] input
+ *     This points to the characters of the path.
+ *
+ * @param[in] length
+ *     This is the number of characters in the path.
+ *
+ * @param[out] output
+ *     This points to where to put what's left of the path, which must
+ *     have room for the given number of characters.  It may be the
+ *     same as the input, but must not otherwise overlap it.
+ *
+ * @return
+ *     The number of characters left in the path is returned.
+ */
+size_t RemoveDotSegments(const char* input, size_t length, char* output);
+
+/**
+ * This function returns the most characters which resolving a
+ * reference against a base could produce, given how many characters
+ * each has.
+ */
+inline size_t GetMaxResolvedLength(size_t baseLength, size_t referenceLength) {
+    // Merging a relative path with the empty path of a base with an
+    // authority puts a slash in front of it; every other character
+    // of the target is one from the base or from the reference.
+    return baseLength + referenceLength + 1;
+}
+
+/**
+ * This function resolves a URI reference against a base URI, as
+ * described in RFC 3986 section 5.2.2, putting the characters of the
+ * target URI together (section 5.3) in the given output.
+ *
+ * @param[in] base
+ *     This points to the characters of the base URI.
+ *
+ * @param[in] baseElements
+ *     This holds where the elements of the base URI are.
+ *
+ * @param[in] reference
+ *     This points to the characters of the reference.
+ *
+ * @param[in] referenceElements
+ *     This holds where the elements of the reference are.
+ *
+ * @param[out] output
+ *     This points to where to put the characters of the target URI,
+ *     which must have room for the number of characters returned by
+ *     GetMaxResolvedLength, and must not overlap the base
+ *     or the reference.
+ *
+ * @return
+ *     Where the elements of the target URI are in the output is
+ *     returned.  The target URI ends where its fragment ends.
+ */
+Elements ResolveReference(
+    const char* base,
+    const Elements& baseElements,
+    const char* reference,
+    const Elements& referenceElements,
+    char* output
+);
+} // namespace Uri
+
+#endif /* URI_RESOLVE_HPP */
@@ -0,0 +1,188 @@
+#ifndef URI_SMALL_BUFFER_HPP
+#define URI_SMALL_BUFFER_HPP
+
+/**
+ * @file SmallBuffer.hpp
+ *
+ * This module declares the Uri::SmallBuffer class template.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+namespace Uri
+{
+/**
+ * This is a growable buffer of characters which keeps up to the given
+ * number of characters inside itself, only going to the heap for
+ * more than that.
+ *
+ * @param[in] InlineCapacity
+ *     This is the number of characters the buffer can hold
+ *     without going to the heap.
+ */
+template< size_t InlineCapacity > class SmallBuffer
+{
+public:
+    // Lifecycle management
+
+    ~SmallBuffer() {
+        free(heap_);
+    }
+
+    SmallBuffer(const SmallBuffer& other) {
+        assign(other.data(), other.size());
+    }
+
+    SmallBuffer(SmallBuffer&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    SmallBuffer& operator=(const SmallBuffer& other) {
+        if (this != &other) {
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    SmallBuffer& operator=(SmallBuffer&& other) noexcept {
+        if (this != &other) {
+            if (other.heap_ == nullptr) {
+                assign(other.inline_, other.size_);
+            } else {
+                free(heap_);
+                heap_ = other.heap_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.heap_ = nullptr;
+                other.capacity_ = InlineCapacity;
+            }
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // Methods
+
+    /**
+     * This is the default constructor, which makes an empty buffer.
+     */
+    SmallBuffer() {
+    }
+
+    /**
+     * This returns a pointer to the first character in the buffer.
+     */
+    char* data() {
+        return (heap_ == nullptr) ? inline_ : heap_;
+    }
+
+    /**
+     * This returns a pointer to the first character in the buffer.
+     */
+    const char* data() const {
+        return (heap_ == nullptr) ? inline_ : heap_;
+    }
+
+    /**
+     * This returns the number of characters in the buffer.
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * This returns the character at the given index in the buffer.
+     */
+    char operator[](size_t index) const {
+        return data()[index];
+    }
+
+    /**
+     * This removes all the characters from the buffer,
+     * keeping the memory it has.
+     */
+    void clear() {
+        size_ = 0;
+    }
+
+    /**
+     * This makes sure the buffer can hold at least the given number
+     * of characters without going to the heap again.
+     */
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        if (capacity < (size_t)capacity_ * 2) {
+            capacity = (size_t)capacity_ * 2;
+        }
+        char* heap = (char*)malloc(capacity);
+        if (heap == nullptr) {
+            throw std::bad_alloc();
+        }
+        memcpy(heap, data(), size_);
+        free(heap_);
+        heap_ = heap;
+        capacity_ = (uint32_t)capacity;
+    }
+
+    /**
+     * This changes the number of characters in the buffer, leaving
+     * any characters added uninitialized.
+     */
+    void resize(size_t size) {
+        reserve(size);
+        size_ = (uint32_t)size;
+    }
+
+    /**
+     * This replaces the characters in the buffer with the given ones.
+     */
+    void assign(const char* characters, size_t length) {
+        size_ = 0;
+        append(characters, length);
+    }
+
+    /**
+     * This adds the given characters to the end of the buffer.
+     */
+    void append(const char* characters, size_t length) {
+        reserve(size_ + length);
+        if (length > 0) {
+            memcpy(data() + size_, characters, length);
+        }
+        size_ += (uint32_t)length;
+    }
+
+private:
+    // Properties
+
+    /**
+     * This points to the characters, if they are on the heap,
+     * or is null if they are in the inline buffer.
+     */
+    char* heap_ = nullptr;
+
+    /**
+     * This is the number of characters in the buffer.
+     */
+    uint32_t size_ = 0;
+
+    /**
+     * This is the number of characters the buffer can hold
+     * before it has to go to the heap again.
+     */
+    uint32_t capacity_ = InlineCapacity;
+
+    /**
+     * This holds the characters, if there are few enough of them.
+     */
+    char inline_[InlineCapacity];
+};
+} // namespace Uri
+
+#endif /* URI_SMALL_BUFFER_HPP */
@@ -0,0 +1,136 @@
+/**
+ * @file StreamingParser.cpp
+ *
+ * This module contains the implementation of the
+ * Uri::StreamingParser class.
+ */
+
+#include <Uri/StreamingParser.hpp>
+
+#include "Parser.hpp"
+
+#include <new>
+
+namespace {
+/**
+ * This returns the state machine held in the given storage.
+ */
+Uri::Parser& ParserIn(unsigned char* storage) {
+    return *reinterpret_cast< Uri::Parser* >(storage);
+}
+
+/**
+ * This returns the state machine held in the given storage.
+ */
+const Uri::Parser& ParserIn(const unsigned char* storage) {
+    return *reinterpret_cast< const Uri::Parser* >(storage);
+}
+}
+
+namespace Uri
+{
+StreamingParser::~StreamingParser() {
+    ParserIn(storage_).~Parser();
+}
+
+StreamingParser::StreamingParser(const StreamingParser& other) {
+    new (storage_) Parser(ParserIn(other.storage_));
+}
+
+StreamingParser& StreamingParser::operator=(const StreamingParser& other) {
+    ParserIn(storage_) = ParserIn(other.storage_);
+    return *this;
+}
+
+StreamingParser::StreamingParser() {
+    static_assert(
+        sizeof(Parser) <= STORAGE_SIZE,
+        "Uri::Parser must fit the storage set aside for it"
+    );
+    static_assert(
+        alignof(Parser) <= 8,
+        "Uri::Parser must fit the alignment of the storage set aside for it"
+    );
+    new (storage_) Parser;
+}
+
+void StreamingParser::Reset() {
+    ParserIn(storage_) = Parser();
+}
+
+bool StreamingParser::Feed(const char* data, size_t length) {
+    auto& parser = ParserIn(storage_);
+    if (parser.state == Parser::Error) {
+        return false;
+    }
+    return parser.Consume(data, length);
+}
+
+bool StreamingParser::Finish() {
+    return ParserIn(storage_).Finish();
+}
+
+bool StreamingParser::HasFailed() const {
+    return (ParserIn(storage_).state == Parser::Error);
+}
+
+size_t StreamingParser::GetErrorOffset() const {
+    return ParserIn(storage_).errorOffset;
+}
+
+size_t StreamingParser::GetConsumed() const {
+    return ParserIn(storage_).consumed;
+}
+
+bool StreamingParser::HasScheme() const {
+    return ParserIn(storage_).elements.hasScheme;
+}
+
+bool StreamingParser::HasAuthority() const {
+    return ParserIn(storage_).elements.hasAuthority;
+}
+
+bool StreamingParser::HasUserInfo() const {
+    return ParserIn(storage_).elements.hasUserInfo;
+}
+
+bool StreamingParser::HasPort() const {
+    return ParserIn(storage_).elements.hasPort;
+}
+
+bool StreamingParser::HasQuery() const {
+    return ParserIn(storage_).elements.hasQuery;
+}
+
+bool StreamingParser::HasFragment() const {
+    return ParserIn(storage_).elements.hasFragment;
+}
+
+uint16_t StreamingParser::GetPort() const {
+    return ParserIn(storage_).elements.port;
+}
+
+UriView::Range StreamingParser::GetSchemeRange() const {
+    return ParserIn(storage_).elements.scheme;
+}
+
+UriView::Range StreamingParser::GetUserInfoRange() const {
+    return ParserIn(storage_).elements.userInfo;
+}
+
+UriView::Range StreamingParser::GetHostRange() const {
+    return ParserIn(storage_).elements.host;
+}
+
+UriView::Range StreamingParser::GetPathRange() const {
+    return ParserIn(storage_).elements.path;
+}
+
+UriView::Range StreamingParser::GetQueryRange() const {
+    return ParserIn(storage_).elements.query;
+}
+
+UriView::Range StreamingParser::GetFragmentRange() const {
+    return ParserIn(storage_).elements.fragment;
+}
+} // namespace Uri
@@ -5,318 +5,837 @@
  */
 
 #include <Uri/Uri.hpp>
-#include <string>
-#include <vector>
 
-namespace {
-/**
- * This function parses the given string as an unsigned 16-bit 
- * integer, detecting invalid characters, overflow, etc.
- * 
- * @param[in] numberString
- *     This is the string containing the number to parse.
- * 
- * @param[out]
- *     This is where to store the number parsed.
- * 
- * @return
- *     An indication of whether or not the number was parsed
- *     successfully is returned.
- */
-bool ParseUint16(const std::string& numberString, uint16_t& number) {
-    uint32_t number32Bits = 0;
-    for(auto c : numberString) {
-        if ((c < '0')|| (c > '9')) {
-            return false;
-        }
-        number32Bits = number32Bits * 10 + uint16_t(c - '0');
-        if (number32Bits & ~((1 << 16) - 1)) {
-            return false;
-        }
-    }
-    number = (uint16_t)number32Bits;
-    return true;
-}
-}
+#include "Compare.hpp"
+#include "FingerprintElements.hpp"
+#include "Normalize.hpp"
+#include "Parser.hpp"
+#include "QueryIndex.hpp"
+#include "Resolve.hpp"
+#include "SmallBuffer.hpp"
+
+#include <new>
+#include <string>
+#include <string.h>
+#include <utility>
 
 namespace Uri
 {
 /**
  * This contains the private properties of a URI instance.
+ *
+ * To keep a parsed URI small, the elements are not held as separate
+ * strings.  Instead, the characters of the URI are kept in one buffer,
+ * exactly as parsed, and a small header records where each element
+ * begins and ends.  The boundaries of the path segments are kept in
+ * the same buffer, in a table just after the characters.
+ *
+ * The header holds 16-bit offsets, which are enough for nearly every
+ * URI.  A URI too long for them has 32-bit offsets instead, kept at
+ * the end of the buffer, after the table of path segment boundaries,
+ * so that the header stays small for every other URI.
+ *
+ * The buffer keeps short URIs inside itself, and is sized so that the
+ * whole structure just fits the storage set aside for it in Uri::Uri,
+ * so a typical URI is parsed without going to the heap at all.
  */
 struct Uri::Impl {
-    // Properties
+    // Types
+
     /**
-     * This field represents whether the URI has scheme or not.
+     * These identify the offsets held in the header.  The scheme
+     * always begins at offset 0, and the table of path segment
+     * boundaries always begins at the end of the fragment, which
+     * is the end of the characters of the URI.
      */
-    bool hasScheme;
+    enum Bound {
+        SchemeEnd,
+        UserInfoBegin,
+        UserInfoEnd,
+        HostBegin,
+        HostEnd,
+        PathBegin,
+        PathEnd,
+        QueryBegin,
+        QueryEnd,
+        FragmentBegin,
+        FragmentEnd,
+        SegmentCount,
+        NumBounds
+    };
 
     /**
-     * This is the "scheme" element of the URI.
+     * These are the bits of the flags field.
      */
-    std::string scheme;
+    enum Flag : uint8_t {
+        HasScheme = 0x01,
+        HasAuthority = 0x02,
+        HasUserInfo = 0x04,
+        HasPort = 0x08,
+        HasQuery = 0x10,
+        HasFragment = 0x20,
+        WideOffsets = 0x40,
+    };
 
     /**
-     * This is the "host" element of the URI.
+     * This is the number of characters the buffer can hold
+     * without going to the heap.
      */
-    std::string host;
+    static constexpr size_t INLINE_CAPACITY = 200;
 
     /**
-     * This is the "path" element of the URI, which
-     * is a vector contains the segments of the path.
+     * This is the number of bytes taken at the end of the buffer
+     * by the offsets of a URI too long for the header.
      */
-    std::vector< std::string > path;
+    static constexpr size_t WIDE_BOUNDS_SIZE = sizeof(uint32_t) * NumBounds;
+
+    // Properties
 
     /**
-     * This flag indicates whether or not the URI 
-     * has a port number.
+     * This holds the characters of the URI, followed by the table
+     * of path segment boundaries.  The table has one entry for each
+     * segment, which is the offset where the segment begins, plus one
+     * more entry, which is one past the offset where the last segment
+     * ends.  Each segment ends one character before the next one begins.
      */
-    bool hasPort;
+    SmallBuffer< INLINE_CAPACITY > buffer;
 
     /**
-     * This is the "port" element of the URI, if exists.
+     * This holds the offsets of the elements of the URI, unless the
+     * flags indicate they're too wide for it, in which case they're
+     * at the end of the buffer instead.
      */
-    uint16_t port;
+    uint16_t bounds[NumBounds] = {0};
 
     /**
-     * This is the "query" element of the URI.
+     * This is the "port" element of the URI, if exists.
      */
-    std::string query;
+    uint16_t port = 0;
 
     /**
-     * This is the "fragment" element of the URI.
+     * These flags indicate which elements the URI has,
+     * and how wide the offsets are.
      */
-    std::string fragment;
+    uint8_t flags = 0;
 
     /**
-     * This is the "user info" element of the URI.
+     * This is the index of the parameters of the query, which is built
+     * the first time a parameter is looked up by key.
      */
-    std::string userInfo;
+    LazyQueryIndex queryIndex;
 
     // Methods
 
     /**
-     * This method builds the internal path element sequence
-     * by parsing it from the given path string.
-     * 
-     * @param[in] pathString
-     *     This is the string containing the whole path of the URI.
-     * 
+     * This method returns an indication of whether or not
+     * the given flag is set.
+     */
+    bool Has(Flag flag) const {
+        return ((flags & flag) != 0);
+    }
+
+    /**
+     * This method returns the given offset from the header.
+     */
+    size_t Get(Bound bound) const {
+        if (Has(WideOffsets)) {
+            uint32_t offset;
+            memcpy(&offset, buffer.data() + WideBoundPosition(bound), sizeof(offset));
+            return offset;
+        }
+        return bounds[bound];
+    }
+
+    /**
+     * This method sets the given offset in the header.
+     */
+    void Set(Bound bound, size_t offset) {
+        if (Has(WideOffsets)) {
+            const auto wideOffset = (uint32_t)offset;
+            memcpy(buffer.data() + WideBoundPosition(bound), &wideOffset, sizeof(wideOffset));
+        } else {
+            bounds[bound] = (uint16_t)offset;
+        }
+    }
+
+    /**
+     * This method returns where in the buffer the given offset is
+     * kept, if the offsets are too wide for the header.
+     */
+    size_t WideBoundPosition(Bound bound) const {
+        return buffer.size() - WIDE_BOUNDS_SIZE + sizeof(uint32_t) * bound;
+    }
+
+    /**
+     * This method returns the characters between the given offsets.
+     */
+    StringView View(size_t begin, size_t end) const {
+        return StringView(buffer.data() + begin, end - begin);
+    }
+
+    /**
+     * This method returns the characters between the given offsets
+     * from the header.  NumBounds may be given as the beginning,
+     * to begin at offset 0.
+     */
+    StringView View(Bound begin, Bound end) const {
+        return View(begin == NumBounds ? 0 : Get(begin), Get(end));
+    }
+
+    /**
+     * This method returns the segments of the path.
+     */
+    PathSegments Segments() const {
+        return PathSegments(
+            buffer.data(),
+            buffer.data() + Get(FragmentEnd),
+            Get(SegmentCount),
+            Has(WideOffsets)
+        );
+    }
+
+    /**
+     * This method appends an entry to the table of
+     * path segment boundaries.
+     */
+    void AppendSegmentBoundary(size_t offset) {
+        if (Has(WideOffsets)) {
+            const auto entry = (uint32_t)offset;
+            buffer.append((const char*)&entry, sizeof(entry));
+        } else {
+            const auto entry = (uint16_t)offset;
+            buffer.append((const char*)&entry, sizeof(entry));
+        }
+    }
+
+    /**
+     * This method takes on the given URI, as found by the parser.
+     *
+     * @param[in] data
+     *     This points to the characters of the URI.
+     *
+     * @param[in] elements
+     *     This holds where the elements of the URI were found.
+     */
+    void Assign(const char* data, const Elements& elements) {
+        buffer.assign(data, GetLength(elements));
+        Adopt(elements);
+    }
+
+    /**
+     * This method takes on the URI whose characters have already been
+     * put at the beginning of the buffer, and possibly more after them.
+     *
+     * @param[in] elements
+     *     This holds where the elements of the URI are in the buffer.
+     */
+    void Adopt(const Elements& elements) {
+        const size_t length = GetLength(elements);
+        flags = (
+            (elements.hasScheme ? HasScheme : 0)
+            | (elements.hasAuthority ? HasAuthority : 0)
+            | (elements.hasUserInfo ? HasUserInfo : 0)
+            | (elements.hasPort ? HasPort : 0)
+            | (elements.hasQuery ? HasQuery : 0)
+            | (elements.hasFragment ? HasFragment : 0)
+            | ((length >= UINT16_MAX) ? WideOffsets : 0)
+        );
+        port = elements.port;
+        buffer.resize(length);
+        const size_t segments = SplitPath(elements.path.begin, elements.path.end);
+        if (Has(WideOffsets)) {
+            buffer.resize(buffer.size() + WIDE_BOUNDS_SIZE);
+        }
+        Set(SchemeEnd, elements.scheme.end);
+        Set(UserInfoBegin, elements.userInfo.begin);
+        Set(UserInfoEnd, elements.userInfo.end);
+        Set(HostBegin, elements.host.begin);
+        Set(HostEnd, elements.host.end);
+        Set(PathBegin, elements.path.begin);
+        Set(PathEnd, elements.path.end);
+        Set(QueryBegin, elements.query.begin);
+        Set(QueryEnd, elements.query.end);
+        Set(FragmentBegin, elements.hasFragment ? elements.fragment.begin : length);
+        Set(FragmentEnd, length);
+        Set(SegmentCount, segments);
+        queryIndex.Reset();
+    }
+
+    /**
+     * This method returns where the elements of the URI are,
+     * in the form the parser finds them.
+     */
+    Elements GetElements() const {
+        Elements elements;
+        elements.scheme.end = Get(SchemeEnd);
+        elements.userInfo.begin = Get(UserInfoBegin);
+        elements.userInfo.end = Get(UserInfoEnd);
+        elements.host.begin = Get(HostBegin);
+        elements.host.end = Get(HostEnd);
+        elements.path.begin = Get(PathBegin);
+        elements.path.end = Get(PathEnd);
+        elements.query.begin = Get(QueryBegin);
+        elements.query.end = Get(QueryEnd);
+        elements.fragment.begin = Get(FragmentBegin);
+        elements.fragment.end = Get(FragmentEnd);
+        elements.port = port;
+        elements.hasScheme = Has(HasScheme);
+        elements.hasAuthority = Has(HasAuthority);
+        elements.hasUserInfo = Has(HasUserInfo);
+        elements.hasPort = Has(HasPort);
+        elements.hasQuery = Has(HasQuery);
+        elements.hasFragment = Has(HasFragment);
+        return elements;
+    }
+
+    /**
+     * This function returns the number of characters of the URI whose
+     * elements are where the given elements say they are.
+     */
+    static size_t GetLength(const Elements& elements) {
+        return elements.hasFragment ? elements.fragment.end : (
+            elements.hasQuery ? elements.query.end : elements.path.end
+        );
+    }
+
+    /**
+     * This method builds the table of path segment boundaries by
+     * splitting the path at its slashes.
+     *
+     * Each character is visited exactly once, so the work done
+     * is linear in the length of the path no matter how many
+     * segments it has.
+     *
+     * @param[in] pathBegin
+     *     This is where the path begins in the buffer.
+     *
+     * @param[in] pathEnd
+     *     This is where the path ends in the buffer.
+     *
      * @return
-     *     An indication if the path was parsed successfully or not
-     *     is returned.
+     *     The number of segments of the path is returned.
      */
-    bool ParsePath(std::string pathString) 
-    {
-        if (pathString == "/") {
-            path.push_back("");
-        } else if (!pathString.empty()) {
-            for(;;) {
-                size_t slashPos = pathString.find('/');
-                path.push_back(pathString.substr(0, slashPos));
-                if (slashPos == std::string::npos) {
-                    break;
+    size_t SplitPath(size_t pathBegin, size_t pathEnd) {
+        size_t segments = 0;
+        if ((pathEnd - pathBegin == 1) && (buffer[pathBegin] == '/')) {
+            // The path "/" is a single empty segment.
+            AppendSegmentBoundary(pathBegin);
+            AppendSegmentBoundary(pathBegin + 1);
+            segments = 1;
+        } else if (pathEnd > pathBegin) {
+            AppendSegmentBoundary(pathBegin);
+            for (size_t i = pathBegin; i < pathEnd; ++i) {
+                if (buffer[i] == '/') {
+                    AppendSegmentBoundary(i + 1);
+                    ++segments;
                 }
-                pathString = pathString.substr(slashPos + 1);
             }
+            AppendSegmentBoundary(pathEnd + 1);
+            ++segments;
         }
-        return true;
+        return segments;
     }
 
     /**
-     * This method parses the elements that make up the authority
-     * composite part of the URI, by parsing it from the given string.
-     * 
-     * @param[in] authorityString
-     *     This is the string containing the whole authority part 
-     *     of the URI.
-     * 
+     * This method works out what goes between the host and the path
+     * when the URI is rendered as a string: a colon and the digits of
+     * the port, without leading zeros, or nothing if the port is
+     * missing or empty.
+     *
+     * @param[out] portText
+     *     This is where to put the characters to write.
+     *
      * @return
-     *     An indication if the authority was parsed successfully or not
-     *     is returned.
+     *     The number of characters to write is returned.
      */
-    bool ParseAuthority(const std::string& authorityString)
-    {
-        std::string hostAndPort;
-        size_t userInfoDelimiter = authorityString.find('@');
-        if (userInfoDelimiter == std::string::npos) {
-            hostAndPort = authorityString;
-        } else {
-            userInfo = authorityString.substr(0, userInfoDelimiter);
-            hostAndPort = authorityString.substr(userInfoDelimiter + 1);
+    size_t FormatPort(char (&portText)[6]) const {
+        if (
+            !Has(HasPort)
+            || (Get(PathBegin) - Get(HostEnd) <= 1)
+        ) {
+            return 0;
         }
+        char digits[5];
+        size_t numDigits = 0;
+        unsigned int value = port;
+        do {
+            digits[numDigits++] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        portText[0] = ':';
+        for (size_t i = 0; i < numDigits; ++i) {
+            portText[i + 1] = digits[numDigits - 1 - i];
+        }
+        return numDigits + 1;
+    }
 
-        // Next, parse the host and port of the authority.
-        size_t hostEnd = hostAndPort.find(':');
-        host = hostAndPort.substr(0, hostEnd);
-        if (hostEnd != std::string::npos) {
-            std::string portString = hostAndPort.substr(hostEnd + 1);
-            if (!ParseUint16(portString, port)) {
-                return false;
-            }
-            hasPort = true;
+    /**
+     * This method returns an indication of whether or not the URI is
+     * rendered as a string exactly as it was parsed, which is when it
+     * has no authority, or its port is already written the way
+     * it's rendered.
+     */
+    bool IsGeneratedAsParsed() const {
+        if (!Has(HasAuthority)) {
+            return true;
         }
-        return true;
+        char portText[6];
+        const size_t portLength = FormatPort(portText);
+        const size_t hostEnd = Get(HostEnd);
+        return (
+            (Get(PathBegin) - hostEnd == portLength)
+            && (memcmp(buffer.data() + hostEnd, portText, portLength) == 0)
+        );
+    }
+
+    /**
+     * This method renders the URI as a string into the given buffer,
+     * which must have room for the number of characters returned by
+     * GeneratedLength.
+     */
+    void Generate(char* output) const {
+        const size_t length = Get(FragmentEnd);
+        if (IsGeneratedAsParsed()) {
+            memcpy(output, buffer.data(), length);
+            return;
+        }
+        char portText[6];
+        const size_t portLength = FormatPort(portText);
+        const size_t hostEnd = Get(HostEnd);
+        const size_t pathBegin = Get(PathBegin);
+        memcpy(output, buffer.data(), hostEnd);
+        memcpy(output + hostEnd, portText, portLength);
+        memcpy(
+            output + hostEnd + portLength,
+            buffer.data() + pathBegin,
+            length - pathBegin
+        );
     }
 
-     /**
-     * This method parses the query and/or fragemnt of the URI
-     * by parsing it from the given string, if exists.
-     * 
-     * @param[in] queryAndOrFragmentString
-     *     This is the string containing the query and/or fragment of the URI.
-     * 
+    /**
+     * This method returns the number of characters
+     * Generate renders the URI as.
+     */
+    size_t GeneratedLength() const {
+        const size_t length = Get(FragmentEnd);
+        if (!Has(HasAuthority)) {
+            return length;
+        }
+        char portText[6];
+        return length - (Get(PathBegin) - Get(HostEnd)) + FormatPort(portText);
+    }
+
+    /**
+     * This method finds the first parameter of the query with the
+     * given key, through the index of the query if it's long enough
+     * to have one, or by searching it from the beginning otherwise.
+     *
+     * @param[in] key
+     *     This is the key to find, as it's written in the query.
+     *
+     * @param[out] value
+     *     This is where to put the value of the parameter, if found.
+     *
      * @return
-     *     An indication if the query and/or fragment was parsed 
-     *     successfully or not is returned.
+     *     An indication of whether or not the query has a parameter
+     *     with the given key is returned.
      */
-    bool ParseQueryAndFragment(const std::string& queryAndOrFragmentString)
-    {
-        size_t fragmentStart = queryAndOrFragmentString.find('#');
-        if (fragmentStart != std::string::npos) {
-            query = queryAndOrFragmentString.substr(0, fragmentStart);
-            fragment = queryAndOrFragmentString.substr(fragmentStart + 1);
-        } else {
-            query = queryAndOrFragmentString;
+    bool FindQueryParameter(const StringView& key, StringView& value) const {
+        const auto query = View(QueryBegin, QueryEnd);
+        const auto index = queryIndex.Get(query);
+        if (index == nullptr) {
+            for (const auto& parameter: QueryParameters(query)) {
+                if (parameter.key == key) {
+                    value = parameter.value;
+                    return true;
+                }
+            }
+            return false;
         }
-        if (query.length() > 0) {
-            query = query.substr(1);
+        const auto parameter = index->Find(query.data(), key);
+        if (parameter == QueryIndex::NONE) {
+            return false;
         }
+        value = index->GetValue(query.data(), parameter);
         return true;
     }
+
+    /**
+     * This method makes the URI empty, keeping the buffer
+     * it has for the next one.
+     */
+    void Clear() {
+        buffer.clear();
+        memset(bounds, 0, sizeof(bounds));
+        port = 0;
+        flags = 0;
+        queryIndex.Reset();
+    }
 };
 
+#if defined(URI_PIMPL)
 Uri::~Uri() = default;
 
+Uri::Uri(const Uri &other)
+    : impl_(other.impl_ ? new Impl(*other.impl_) : new Impl)
+{
+}
+
+Uri::Uri(Uri &&other) noexcept = default;
+
+Uri &Uri::operator=(const Uri &other)
+{
+    if (this != &other) {
+        if (impl_) {
+            *impl_ = other.impl();
+        } else {
+            impl_.reset(new Impl(other.impl()));
+        }
+    }
+    return *this;
+}
+
+Uri &Uri::operator=(Uri &&other) noexcept = default;
+
 Uri::Uri()
     : impl_(new Impl)
 {
 }
 
-void Uri::reset_impl() 
+const Uri::Impl &Uri::impl() const
 {
-    impl_->hasScheme = false;
-    impl_->scheme.clear();
-    impl_->host.clear();
-    impl_->path.clear();
-    impl_->hasPort = false;
-    impl_->port = 0;
-    impl_->query.clear();
-    impl_->fragment.clear();
-    impl_->userInfo.clear();
+    if (impl_) {
+        return *impl_;
+    }
+    static const Impl empty;
+    return empty;
 }
 
-bool Uri::ParseFromString(const std::string &uriString)
+Uri::Impl &Uri::impl()
 {
-    // Reset URI before parse new URI string
-    reset_impl();
+    // A URI which was moved from has no private properties, until
+    // it's changed again, when it gets those of an empty URI.
+    if (!impl_) {
+        impl_.reset(new Impl);
+    }
+    return *impl_;
+}
 
-    // Parse the scheme
-    std::string rest = uriString;
-    size_t schemeEnd = rest.find(':');
-    if (schemeEnd == std::string::npos) {
-        impl_->hasScheme = false;
-    } else {
-        impl_->hasScheme = true;
-        impl_->scheme = rest.substr(0, schemeEnd);
-        rest = rest.substr(schemeEnd + 1);
+void Uri::reset_impl() 
+{
+    if (!impl_) {
+        impl_.reset(new Impl);
+        return;
     }
+    impl_->Clear();
+}
+#else
+Uri::~Uri()
+{
+    impl().~Impl();
+}
 
-    size_t pathEnd = rest.find_first_of("?#");
-    std::string authorityAndPathString = rest.substr(0, pathEnd);
-    std::string pathString;
-    std::string queryAndOrFragment;
+Uri::Uri(const Uri &other)
+{
+    new (storage_) Impl(other.impl());
+}
 
-    // Next parse the authority
-    if (authorityAndPathString.substr(0, 2) == "//") {
-        // Strip the authority marker.
-        authorityAndPathString = authorityAndPathString.substr(2);
+Uri::Uri(Uri &&other) noexcept
+{
+    new (storage_) Impl(std::move(other.impl()));
+    other.reset_impl();
+}
 
-        // First separate the authority from the path.
-        size_t authorityEnd = authorityAndPathString.find('/');
-        if (authorityEnd == std::string::npos) {
-            authorityEnd = authorityAndPathString.length();
-        }
-        pathString = authorityAndPathString.substr(authorityEnd);
-        std::string authorityString = authorityAndPathString.substr(
-            0, authorityEnd);
-        
-        // Parse the elements inside the authority string
-        if (!impl_->ParseAuthority(authorityString)) {
-            return false;
-        }
+Uri &Uri::operator=(const Uri &other)
+{
+    if (this != &other) {
+        impl() = other.impl();
+    }
+    return *this;
+}
 
-        // Next, check if there is a UserInfo, and if so, extract it.
-        
-    } else {
-        pathString = authorityAndPathString;
+Uri &Uri::operator=(Uri &&other) noexcept
+{
+    if (this != &other) {
+        impl() = std::move(other.impl());
+        other.reset_impl();
     }
+    return *this;
+}
+
+Uri::Uri()
+{
+    static_assert(
+        sizeof(Impl) <= INLINE_STORAGE_SIZE,
+        "Uri::Impl must fit the storage set aside for it"
+    );
+    static_assert(
+        alignof(Impl) <= 8,
+        "Uri::Impl must fit the alignment of the storage set aside for it"
+    );
+    new (storage_) Impl;
+}
 
-    // Next, parse the path.
-    if (!impl_->ParsePath(pathString)) {
+const Uri::Impl &Uri::impl() const
+{
+    return *reinterpret_cast< const Impl* >(storage_);
+}
+
+Uri::Impl &Uri::impl()
+{
+    return *reinterpret_cast< Impl* >(storage_);
+}
+
+void Uri::reset_impl()
+{
+    impl().Clear();
+}
+#endif
+
+bool Uri::ParseFromString(const std::string &uriString)
+{
+    // Reset URI before parse new URI string
+    reset_impl();
+
+    // Locate the elements of the URI without copying anything.
+    Parser parser;
+    if (!parser.Parse(uriString.data(), uriString.length())) {
         return false;
     }
 
-    // Finally, parse the query and the fragment.
-    if (pathEnd != std::string::npos) {
-        queryAndOrFragment = rest.substr(pathEnd);
-        impl_->ParseQueryAndFragment(queryAndOrFragment);
-    }
+    // Keep a copy of the URI, along with where its elements are.
+    impl().Assign(uriString.data(), parser.elements);
     return true;
 }
 
-std::string Uri::GetScheme() const
+StringView Uri::GetScheme() const
 {
-    return impl_->scheme;
+    return impl().View(Impl::NumBounds, Impl::SchemeEnd);
 }
 
-std::string Uri::GetHost() const
+StringView Uri::GetHost() const
 {
-    return impl_->host;
+    return impl().View(Impl::HostBegin, Impl::HostEnd);
 }
 
-std::vector<std::string> Uri::GetPath() const
+PathSegments Uri::GetPath() const
 {
-    return impl_->path;
+    return impl().Segments();
 }
 
 bool Uri::HasPort() const
 {
-    return impl_->hasPort;
+    return impl().Has(Impl::HasPort);
 }
 
 uint16_t Uri::GetPort() const
 {
-    return impl_->port;
+    return impl().port;
 }
 
 bool Uri::IsRelativeReference() const
 {
-    return impl_->scheme.empty();
+    return !impl().Has(Impl::HasScheme);
 }
 
 bool Uri::ContainsRelativePath() const
 {
-    if (impl_->path.empty()) {
-        return true;
+    const auto path = impl().View(Impl::PathBegin, Impl::PathEnd);
+    return path.empty() || (path[0] != '/');
+}
+
+StringView Uri::GetQuery() const
+{
+    return impl().View(Impl::QueryBegin, Impl::QueryEnd);
+}
+
+QueryParameters Uri::GetQueryParameters() const
+{
+    return QueryParameters(GetQuery());
+}
+
+bool Uri::HasQueryParameter(const StringView &key) const
+{
+    StringView value;
+    return impl().FindQueryParameter(key, value);
+}
+
+StringView Uri::GetQueryParameter(const StringView &key) const
+{
+    StringView value;
+    (void)impl().FindQueryParameter(key, value);
+    return value;
+}
+
+std::vector< StringView > Uri::GetAllQueryParameters(const StringView &key) const
+{
+    std::vector< StringView > values;
+    const auto& uriImpl = impl();
+    const auto query = uriImpl.View(Impl::QueryBegin, Impl::QueryEnd);
+    const auto index = uriImpl.queryIndex.Get(query);
+    if (index == nullptr) {
+        for (const auto& parameter: QueryParameters(query)) {
+            if (parameter.key == key) {
+                values.push_back(parameter.value);
+            }
+        }
     } else {
-        return !impl_->path[0].empty();
-    } 
+        for (
+            auto parameter = index->Find(query.data(), key);
+            parameter != QueryIndex::NONE;
+            parameter = index->Next(parameter)
+        ) {
+            values.push_back(index->GetValue(query.data(), parameter));
+        }
+    }
+    return values;
 }
 
-std::string Uri::GetQuery() const
+StringView Uri::GetFragment() const
 {
-    return impl_->query;
+    return impl().View(Impl::FragmentBegin, Impl::FragmentEnd);
 }
 
-std::string Uri::GetFragment() const
+StringView Uri::GetUserInfo() const
 {
-    return impl_->fragment;
+    return impl().View(Impl::UserInfoBegin, Impl::UserInfoEnd);
 }
 
-std::string Uri::GetUserInfo() const
+void Uri::Normalize()
 {
-    return impl_->userInfo;
+    auto& uriImpl = impl();
+    SmallBuffer< Impl::INLINE_CAPACITY > normalized;
+    normalized.resize(GetMaxNormalizedLength(uriImpl.Get(Impl::FragmentEnd)));
+    const auto elements = NormalizeElements(
+        uriImpl.buffer.data(),
+        uriImpl.GetElements(),
+        normalized.data()
+    );
+    uriImpl.buffer = std::move(normalized);
+    uriImpl.Adopt(elements);
 }
 
-} // namespace Uri
\ No newline at end of file
+bool Uri::operator==(const Uri &other) const
+{
+    // URIs which render as strings of different lengths
+    // can't be equal, and most URIs which differ do.
+    const auto& uriImpl = impl();
+    const auto& otherImpl = other.impl();
+    if (uriImpl.GeneratedLength() != otherImpl.GeneratedLength()) {
+        return false;
+    }
+    return CompareElements(
+        uriImpl.buffer.data(),
+        uriImpl.GetElements(),
+        otherImpl.buffer.data(),
+        otherImpl.GetElements()
+    ) == 0;
+}
+
+bool Uri::operator!=(const Uri &other) const
+{
+    return !(*this == other);
+}
+
+bool Uri::operator<(const Uri &other) const
+{
+    return CompareElements(
+        impl().buffer.data(),
+        impl().GetElements(),
+        other.impl().buffer.data(),
+        other.impl().GetElements()
+    ) < 0;
+}
+
+bool Uri::EquivalentTo(const Uri &other) const
+{
+    return AreEquivalent(
+        impl().buffer.data(),
+        impl().GetElements(),
+        other.impl().buffer.data(),
+        other.impl().GetElements()
+    );
+}
+
+Uri Resolve(const Uri& base, const Uri& reference)
+{
+    const auto& baseImpl = base.impl();
+    const auto& referenceImpl = reference.impl();
+    Uri target;
+    auto& targetImpl = target.impl();
+    targetImpl.buffer.resize(
+        GetMaxResolvedLength(
+            baseImpl.Get(Uri::Impl::FragmentEnd),
+            referenceImpl.Get(Uri::Impl::FragmentEnd)
+        )
+    );
+    const auto elements = ResolveReference(
+        baseImpl.buffer.data(),
+        baseImpl.GetElements(),
+        referenceImpl.buffer.data(),
+        referenceImpl.GetElements(),
+        targetImpl.buffer.data()
+    );
+    targetImpl.Adopt(elements);
+    return target;
+}
+
+void Fingerprint(
+    const Uri& uri,
+    const FingerprintOptions& options,
+    Fingerprint128& fingerprint
+)
+{
+    const auto& uriImpl = uri.impl();
+    fingerprint = FingerprintElements(
+        uriImpl.buffer.data(),
+        uriImpl.GetElements(),
+        options
+    );
+}
+
+size_t Uri::GetStringLength() const
+{
+    return impl().GeneratedLength();
+}
+
+std::string Uri::GenerateString() const
+{
+    // Usually the characters are copied as they are, which the string
+    // can do as it's constructed, rather than filling itself first.
+    if (impl().IsGeneratedAsParsed()) {
+        return std::string(impl().buffer.data(), impl().Get(Impl::FragmentEnd));
+    }
+    std::string uriString(impl().GeneratedLength(), '\0');
+    if (!uriString.empty()) {
+        impl().Generate(&uriString[0]);
+    }
+    return uriString;
+}
+
+size_t Uri::GenerateString(char* buffer, size_t size) const
+{
+    const size_t length = impl().GeneratedLength();
+    if (length <= size) {
+        impl().Generate(buffer);
+    }
+    return length;
+}
+
+} // namespace Uri
+
+size_t std::hash< Uri::Uri >::operator()(const Uri::Uri &uri) const noexcept
+{
+    // Every element goes in, with the query as it's written, since
+    // URIs with their query parameters in different orders
+    // are not the same.
+    static const Uri::FingerprintOptions options = []{
+        Uri::FingerprintOptions allElements;
+        allElements.elements = Uri::FINGERPRINT_ALL;
+        allElements.unorderedQuery = false;
+        return allElements;
+    }();
+    uint64_t fingerprint;
+    Uri::Fingerprint(uri, options, fingerprint);
+    return (size_t)fingerprint;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file UriView.cpp
+ *
+ * This module contains the implementation of the Uri::UriView class.
+ */
+
+#include <Uri/UriView.hpp>
+
+#include "Parser.hpp"
+
+namespace Uri
+{
+bool UriView::ParseFromString(const char *data, size_t length)
+{
+    *this = UriView();
+    Parser parser;
+    if (!parser.Parse(data, length)) {
+        return false;
+    }
+    data_ = data;
+    const auto& elements = parser.elements;
+    scheme_ = elements.scheme;
+    userInfo_ = elements.userInfo;
+    host_ = elements.host;
+    path_ = elements.path;
+    query_ = elements.query;
+    fragment_ = elements.fragment;
+    port_ = elements.port;
+    hasScheme_ = elements.hasScheme;
+    hasAuthority_ = elements.hasAuthority;
+    hasUserInfo_ = elements.hasUserInfo;
+    hasPort_ = elements.hasPort;
+    hasQuery_ = elements.hasQuery;
+    hasFragment_ = elements.hasFragment;
+    return true;
+}
+
+bool UriView::ParseFromString(const std::string &uriString)
+{
+    return ParseFromString(uriString.data(), uriString.length());
+}
+} // namespace Uri
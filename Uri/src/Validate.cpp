@@ -0,0 +1,56 @@
+/**
+ * @file Validate.cpp
+ *
+ * This module contains the implementation of the functions which
+ * check whether or not characters make up a valid URI.
+ */
+
+#include <Uri/Validate.hpp>
+
+#include "Parser.hpp"
+
+namespace {
+/**
+ * These are the descriptions of the reasons why characters might not
+ * make up a valid URI, in the same order as the ValidationError
+ * enumeration.
+ */
+const char* const validationErrorNames[] = {
+    "none",
+    "illegal character",
+    "misplaced character",
+    "bad percent-encoding",
+    "bad port",
+    "bad IP literal",
+};
+}
+
+namespace Uri
+{
+const char* GetValidationErrorName(ValidationError error) {
+    return validationErrorNames[(int)error];
+}
+
+ValidationResult Validate(const char* data, size_t length) {
+    ValidationResult result;
+    Parser parser;
+    if (!parser.Parse(data, length)) {
+        result.error = parser.errorReason;
+        result.errorOffset = parser.errorOffset;
+    }
+    return result;
+}
+
+ValidationResult Validate(const std::string& uriString) {
+    return Validate(uriString.data(), uriString.length());
+}
+
+bool IsValid(const char* data, size_t length) {
+    Parser parser;
+    return parser.Parse(data, length);
+}
+
+bool IsValid(const std::string& uriString) {
+    return IsValid(uriString.data(), uriString.length());
+}
+} // namespace Uri
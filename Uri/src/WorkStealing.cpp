@@ -0,0 +1,149 @@
+/**
+ * @file WorkStealing.cpp
+ *
+ * This module contains the implementation of the
+ * Uri::RunWorkStealing function.
+ */
+
+#include "WorkStealing.hpp"
+
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * This holds the tasks remaining to one thread, which are always
+ * a contiguous range of task numbers.  The owning thread takes
+ * tasks from the front, and thieves take them from the back.
+ */
+class TaskRange {
+public:
+    /**
+     * This method takes the next task from the front of the range.
+     *
+     * @param[out] task
+     *     This is where to put the number of the task taken.
+     *
+     * @return
+     *     An indication of whether or not there was a task
+     *     to take is returned.
+     */
+    bool TakeFront(size_t& task) {
+        std::lock_guard< std::mutex > lock(mutex_);
+        if (begin_ == end_) {
+            return false;
+        }
+        task = begin_++;
+        return true;
+    }
+
+    /**
+     * This method takes the back half of the range, rounded up,
+     * and gives it to the given range, which must be empty.
+     *
+     * @param[in,out] thief
+     *     This is the range to which to give the tasks taken.
+     *
+     * @return
+     *     An indication of whether or not there were any tasks
+     *     to take is returned.
+     */
+    bool StealHalfInto(TaskRange& thief) {
+        size_t begin, end;
+        {
+            std::lock_guard< std::mutex > lock(mutex_);
+            if (begin_ == end_) {
+                return false;
+            }
+            begin = begin_ + (end_ - begin_) / 2;
+            end = end_;
+            end_ = begin;
+        }
+        thief.Assign(begin, end);
+        return true;
+    }
+
+    /**
+     * This method replaces the range with the given one.
+     */
+    void Assign(size_t begin, size_t end) {
+        std::lock_guard< std::mutex > lock(mutex_);
+        begin_ = begin;
+        end_ = end;
+    }
+
+private:
+    std::mutex mutex_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+};
+
+/**
+ * This function is run by each thread, and runs tasks until
+ * there are none left anywhere.
+ */
+void Work(
+    size_t self,
+    std::vector< std::unique_ptr< TaskRange > >& ranges,
+    const std::function< void(size_t task, size_t thread) >& run
+) {
+    const size_t numThreads = ranges.size();
+    size_t task;
+    for (;;) {
+        if (ranges[self]->TakeFront(task)) {
+            run(task, self);
+            continue;
+        }
+        bool stole = false;
+        for (size_t i = 1; (i < numThreads) && !stole; ++i) {
+            stole = ranges[(self + i) % numThreads]->StealHalfInto(*ranges[self]);
+        }
+        if (!stole) {
+            // No new tasks are ever made, so once every range has been
+            // found empty, the only tasks left are those being run.
+            return;
+        }
+    }
+}
+}
+
+namespace Uri
+{
+void RunWorkStealing(
+    size_t numTasks,
+    size_t numThreads,
+    const std::function< void(size_t task, size_t thread) >& run
+) {
+    if (numThreads > numTasks) {
+        numThreads = numTasks;
+    }
+    if (numThreads <= 1) {
+        for (size_t task = 0; task < numTasks; ++task) {
+            run(task, 0);
+        }
+        return;
+    }
+    std::vector< std::unique_ptr< TaskRange > > ranges;
+    for (size_t i = 0; i < numThreads; ++i) {
+        ranges.emplace_back(new TaskRange);
+        ranges[i]->Assign(numTasks * i / numThreads, numTasks * (i + 1) / numThreads);
+    }
+    std::vector< std::thread > threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+        try {
+            threads.emplace_back(Work, i, std::ref(ranges), std::cref(run));
+        } catch (const std::system_error&) {
+            // The tasks of threads which couldn't be started
+            // are stolen by those which could.
+            break;
+        }
+    }
+    Work(0, ranges, run);
+    for (auto& thread: threads) {
+        thread.join();
+    }
+}
+} // namespace Uri
@@ -0,0 +1,46 @@
+#ifndef URI_WORK_STEALING_HPP
+#define URI_WORK_STEALING_HPP
+
+/**
+ * @file WorkStealing.hpp
+ *
+ * This module declares the Uri::RunWorkStealing function, which
+ * spreads a set of independent tasks across threads.
+ */
+
+#include <functional>
+#include <stddef.h>
+
+namespace Uri
+{
+/**
+ * This function runs a set of independent tasks, numbered from zero,
+ * across the given number of threads, returning once they're all done.
+ *
+ * Each thread starts out owning an equal, contiguous share of the
+ * tasks, which it runs in order.  A thread which runs out of tasks
+ * steals the second half of the tasks remaining to another thread,
+ * so threads which get ahead take work from those which fall behind.
+ *
+ * The calling thread is one of the threads.  If the others can't all
+ * be started, the tasks are run by those which could.
+ *
+ * @param[in] numTasks
+ *     This is the number of tasks to run.
+ *
+ * @param[in] numThreads
+ *     This is the number of threads to run them on.
+ *
+ * @param[in] run
+ *     This is called to run each task, given the number of the task
+ *     and the number, from zero, of the thread running it.  Calls
+ *     from different threads happen at the same time.
+ */
+void RunWorkStealing(
+    size_t numTasks,
+    size_t numThreads,
+    const std::function< void(size_t task, size_t thread) >& run
+);
+} // namespace Uri
+
+#endif /* URI_WORK_STEALING_HPP */
@@ -0,0 +1,68 @@
+/**
+ * @file AllocationTests.cpp
+ *
+ * This module contains the unit tests which check that the Uri::Uri
+ * class doesn't allocate from the heap where it shouldn't.  They are
+ * built into a program of their own, whose allocations are counted,
+ * so that counting them doesn't affect the other unit tests.
+ */
+
+#include "HeapAllocations.hpp"
+
+#include <gtest/gtest.h>
+#include <Uri/Uri.hpp>
+
+#include <string>
+#include <utility>
+
+#if !defined(URI_PIMPL)
+TEST(AllocationTests, ParseTypicalUriWithoutHeapAllocation)
+{
+  const std::string uriString = "https://joe@www.example.com:8080/docs/2024/guide/index.html?lang=en&page=3#install";
+  const size_t allocationsBefore = GetHeapAllocations();
+  {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString(uriString));
+    ASSERT_EQ("www.example.com", uri.GetHost());
+    ASSERT_EQ(5, uri.GetPath().size());
+    ASSERT_EQ("index.html", uri.GetPath().back());
+    Uri::Uri copy(uri);
+    Uri::Uri moved(std::move(copy));
+    ASSERT_EQ("install", moved.GetFragment());
+  }
+  ASSERT_EQ(allocationsBefore, GetHeapAllocations());
+}
+#endif
+
+TEST(AllocationTests, GenerateStringIntoBufferWithoutHeapAllocation)
+{
+  Uri::Uri uri;
+  ASSERT_TRUE(uri.ParseFromString("http://example.com:08/a"));
+  char buffer[32];
+  const size_t allocationsBefore = GetHeapAllocations();
+  ASSERT_EQ(22, uri.GenerateString(buffer, sizeof(buffer)));
+  ASSERT_EQ(allocationsBefore, GetHeapAllocations());
+  ASSERT_EQ("http://example.com:8/a", std::string(buffer, 22));
+}
+
+#if !defined(URI_PIMPL)
+TEST(AllocationTests, CompareWithoutHeapAllocation)
+{
+  Uri::Uri uri, other;
+  ASSERT_TRUE(uri.ParseFromString("HTTP://www.Example.com:80/docs/./guide/%7Eindex.html?lang=en#install"));
+  ASSERT_TRUE(other.ParseFromString("http://www.example.com/docs/guide/~index.html?lang=en#install"));
+  const size_t allocationsBefore = GetHeapAllocations();
+  ASSERT_FALSE(uri == other);
+  ASSERT_TRUE(uri != other);
+  ASSERT_TRUE(uri < other);
+  ASSERT_TRUE(uri.EquivalentTo(other));
+  ASSERT_EQ(allocationsBefore, GetHeapAllocations());
+}
+#endif
+
+TEST(AllocationTests, CountsAllocations)
+{
+  const size_t allocationsBefore = GetHeapAllocations();
+  std::string longString(1000, 'x');
+  ASSERT_LT(allocationsBefore, GetHeapAllocations());
+}
@@ -0,0 +1,175 @@
+/**
+ * @file BaseResolverTests.cpp
+ *
+ * This module contains the unit tests of the Uri::BaseResolver class.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/BaseResolver.hpp>
+#include <Uri/Uri.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * These are references of every kind, valid and not,
+ * to resolve against each base.
+ */
+const std::vector< std::string > testReferences{
+  "g:h",
+  "g",
+  "./g",
+  "g/",
+  "/g",
+  "//g",
+  "?y",
+  "g?y#s",
+  "#s",
+  "",
+  ".",
+  "..",
+  "../../../g",
+  "g;x=1/../y",
+  "g#s/../x",
+  "a b",
+  "_:/x",
+  "deep/er/path/file.html?x=1",
+  "setup.html",
+  "images/diagram-1.png",
+  "g.",
+  ".g",
+  "g..",
+  "..g",
+  "g/./h",
+  "g/..",
+  "http://other.example/./x",
+};
+
+/**
+ * These are bases with and without authorities, paths,
+ * and dot segments.
+ */
+const std::vector< std::string > testBases{
+  "http://a/b/c/d;p?q",
+  "http://a",
+  "https://joe@h:81/x/y/",
+  "http://a/b/./c/../d",
+  "http://a/docs/v1.2/index.html",
+  "http://a/b/..",
+  "x:a/b",
+  "x:a",
+};
+
+/**
+ * This resolves the given reference against the given base
+ * with Uri::Resolve, to compare with.
+ */
+std::string ExpectedTarget(const std::string &baseString, const std::string &referenceString) {
+  Uri::Uri base;
+  Uri::Uri reference;
+  if (!base.ParseFromString(baseString) || !reference.ParseFromString(referenceString)) {
+    return "invalid";
+  }
+  return Uri::Resolve(base, reference).GenerateString();
+}
+}
+
+TEST(BaseResolverTests, ResolveOneAtATimeMatchesUriResolve)
+{
+  for (const auto &baseString : testBases) {
+    Uri::BaseResolver resolver;
+    ASSERT_TRUE(resolver.SetBase(baseString)) << baseString;
+    ASSERT_EQ(baseString, resolver.GetBase());
+    for (const auto &referenceString : testReferences) {
+      std::string target = "invalid";
+      (void)resolver.Resolve(referenceString.data(), referenceString.length(), target);
+      ASSERT_EQ(ExpectedTarget(baseString, referenceString), target)
+        << baseString << " + " << referenceString;
+    }
+  }
+}
+
+TEST(BaseResolverTests, ResolveBatchMatchesUriResolve)
+{
+  std::string buffer;
+  std::vector< size_t > offsets{0};
+  for (size_t i = 0; i < 100; ++i) {
+    buffer += testReferences[i % testReferences.size()];
+    offsets.push_back(buffer.length());
+  }
+  for (const auto &baseString : testBases) {
+    Uri::BaseResolver resolver;
+    ASSERT_TRUE(resolver.SetBase(baseString)) << baseString;
+    Uri::ResolvedBatch results;
+    const size_t numValid = resolver.ResolveBatch(buffer.data(), offsets.data(), 100, results);
+    ASSERT_EQ(100, results.count);
+    size_t expectedValid = 0;
+    for (size_t i = 0; i < 100; ++i) {
+      const auto &referenceString = testReferences[i % testReferences.size()];
+      const auto expected = ExpectedTarget(baseString, referenceString);
+      if (expected == "invalid") {
+        ASSERT_FALSE(results.IsValid(i)) << referenceString;
+        ASSERT_TRUE(results.Get(i).empty()) << referenceString;
+      } else {
+        ASSERT_TRUE(results.IsValid(i)) << referenceString;
+        ASSERT_EQ(expected, results.Get(i)) << baseString << " + " << referenceString;
+        ++expectedValid;
+      }
+    }
+    ASSERT_EQ(expectedValid, numValid);
+    ASSERT_EQ(results.offsets[100], results.arena.length());
+  }
+}
+
+TEST(BaseResolverTests, EmptyBatchAndBadBase)
+{
+  Uri::BaseResolver resolver;
+  ASSERT_FALSE(resolver.SetBase("http://exa mple/"));
+  ASSERT_TRUE(resolver.GetBase().empty());
+  Uri::ResolvedBatch results;
+  const size_t offsets[] = {0};
+  ASSERT_EQ(0, resolver.ResolveBatch("", offsets, 0, results));
+  ASSERT_EQ(0, results.count);
+  ASSERT_TRUE(results.arena.empty());
+
+  ASSERT_TRUE(resolver.SetBase("http://example.com/a/"));
+  Uri::BaseResolver copy(resolver);
+  Uri::BaseResolver moved(std::move(resolver));
+  std::string target;
+  ASSERT_TRUE(copy.Resolve("b", 1, target));
+  ASSERT_EQ("http://example.com/a/b", target);
+  ASSERT_TRUE(moved.Resolve("../c", 4, target));
+  ASSERT_EQ("http://example.com/c", target);
+  ASSERT_FALSE(moved.Resolve("a b", 3, target));
+  ASSERT_EQ("http://example.com/c", target);
+}
+
+TEST(BaseResolverTests, MovedFromResolver)
+{
+  Uri::BaseResolver resolver;
+  ASSERT_TRUE(resolver.SetBase("http://example.com/a/"));
+  Uri::BaseResolver moved(std::move(resolver));
+
+  // A resolver which was moved from is one with an empty base,
+  // which can be copied, and given a base again.
+  std::string target;
+  ASSERT_TRUE(resolver.GetBase().empty());
+  ASSERT_TRUE(resolver.Resolve("b", 1, target));
+  ASSERT_EQ("b", target);
+  Uri::BaseResolver copy(resolver);
+  ASSERT_TRUE(copy.GetBase().empty());
+  moved = resolver;
+  ASSERT_TRUE(moved.GetBase().empty());
+  ASSERT_TRUE(resolver.SetBase("http://example.com/c/"));
+  ASSERT_TRUE(resolver.Resolve("d", 1, target));
+  ASSERT_EQ("http://example.com/c/d", target);
+
+  Uri::BaseResolver other(std::move(resolver));
+  other = std::move(resolver);
+  ASSERT_TRUE(other.GetBase().empty());
+  Uri::ResolvedBatch results;
+  const size_t offsets[] = {0, 1};
+  ASSERT_EQ(1, other.ResolveBatch("e", offsets, 1, results));
+  ASSERT_EQ("e", results.Get(0));
+}
@@ -0,0 +1,56 @@
+/**
+ * @file CharacterClassesTests.cpp
+ *
+ * This module contains the unit tests of the character classes
+ * of the Uri library.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/CharacterClasses.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+using namespace Uri::CharacterClasses;
+
+static_assert(Is('a', ALPHA), "the table should be usable at compile time");
+static_assert(!Is('%', PCHAR), "the table should be usable at compile time");
+static_assert(GetClasses('\x80') == 0, "non-ASCII characters belong to no class");
+}
+
+TEST(CharacterClassesTests, ClassesMatchRfc3986)
+{
+  const std::string alpha = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+  const std::string digit = "0123456789";
+  const std::string unreserved = alpha + digit + "-._~";
+  const std::string subDelims = "!$&'()*+,;=";
+  const std::string pchar = unreserved + subDelims + ":@";
+  struct TestVector {
+    uint16_t characterClass;
+    std::string members;
+  };
+  std::vector< TestVector > testVector {
+    {ALPHA, alpha},
+    {DIGIT, digit},
+    {HEXDIG, digit + "ABCDEFabcdef"},
+    {UNRESERVED, unreserved},
+    {SUB_DELIMS, subDelims},
+    {GEN_DELIMS, ":/?#[]@"},
+    {SCHEME, alpha + digit + "+-."},
+    {USER_INFO, unreserved + subDelims + ":"},
+    {REG_NAME, unreserved + subDelims},
+    {PCHAR, pchar},
+    {QUERY_OR_FRAGMENT, pchar + "/?"},
+  };
+  for (const auto &test : testVector) {
+    for (int c = 0; c < 256; ++c) {
+      const bool expected = (
+        (c != 0)
+        && (test.members.find((char)c) != std::string::npos)
+      );
+      ASSERT_EQ(expected, Is((char)c, test.characterClass))
+        << "class " << test.characterClass << ", character " << c;
+    }
+  }
+}
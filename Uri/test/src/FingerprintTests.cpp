@@ -0,0 +1,195 @@
+/**
+ * @file FingerprintTests.cpp
+ *
+ * This module contains the unit tests of the functions which compute
+ * a fingerprint of selected elements of a URI.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/Fingerprint.hpp>
+#include <Uri/Uri.hpp>
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+/**
+ * This computes the 128-bit fingerprint of the given URI, both
+ * straight from its characters and from it parsed, checks that
+ * they agree, and returns it.
+ */
+Uri::Fingerprint128 FingerprintBothWays(
+  const std::string &uriString,
+  const Uri::FingerprintOptions &options
+) {
+  Uri::Fingerprint128 fingerprint;
+  EXPECT_TRUE(Uri::Fingerprint(uriString.data(), uriString.length(), options, fingerprint)) << uriString;
+  Uri::Uri uri;
+  EXPECT_TRUE(uri.ParseFromString(uriString)) << uriString;
+  Uri::Fingerprint128 parsedFingerprint;
+  Uri::Fingerprint(uri, options, parsedFingerprint);
+  EXPECT_EQ(fingerprint, parsedFingerprint) << uriString;
+  uint64_t fingerprint64 = 0;
+  EXPECT_TRUE(Uri::Fingerprint(uriString.data(), uriString.length(), options, fingerprint64)) << uriString;
+  EXPECT_EQ(fingerprint.low, fingerprint64) << uriString;
+  return fingerprint;
+}
+
+/**
+ * This makes the choices of fingerprint which take in every
+ * element of the URI, with the query as it's written.
+ */
+Uri::FingerprintOptions AllElementsInOrder() {
+  Uri::FingerprintOptions options;
+  options.elements = Uri::FINGERPRINT_ALL;
+  options.unorderedQuery = false;
+  return options;
+}
+}
+
+TEST(FingerprintTests, SameForEquivalentUris)
+{
+  const std::vector< std::pair< std::string, std::string > > equivalentUris{
+    {"HTTP://Example.COM:80/a/./b/%7e", "http://example.com/a/b/~"},
+    {"http://example.com", "http://example.com:/"},
+    {"https://EXAMPLE.com:443/x?q=%3d#%7Ef", "https://example.com/x?q=%3D#~f"},
+    {"http://a/b/c/../d/%2E/e", "http://a/b/d/e"},
+    {"foo:/a/..//bar/x", "foo:/.//bar/x"},
+  };
+  const auto options = AllElementsInOrder();
+  for (const auto &pair : equivalentUris) {
+    ASSERT_EQ(FingerprintBothWays(pair.first, options), FingerprintBothWays(pair.second, options))
+      << pair.first << " vs " << pair.second;
+
+    // The fingerprint is the same as that of the URI normalized.
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString(pair.first));
+    uri.Normalize();
+    ASSERT_EQ(FingerprintBothWays(pair.first, options), FingerprintBothWays(uri.GenerateString(), options));
+  }
+}
+
+TEST(FingerprintTests, DifferentForDifferentUris)
+{
+  const std::vector< std::string > differentUris{
+    "http://example.com/",
+    "https://example.com/",
+    "http://example.com:8080/",
+    "http://example.org/",
+    "http://example.com/a",
+    "http://example.com/?",
+    "http://example.com/#",
+    "http://example.com/?a",
+    "http://example.com/#a",
+    "http://joe@example.com/",
+    "http://example.com/a?b",
+    "http://example.com/a%2Fb",
+    "http://example.com/a/b",
+    "//example.com/",
+    "example.com/",
+    "foo:/.//bar/x",
+    "foo://bar/x",
+  };
+  const auto options = AllElementsInOrder();
+  std::set< std::pair< uint64_t, uint64_t > > fingerprints;
+  for (const auto &uriString : differentUris) {
+    const auto fingerprint = FingerprintBothWays(uriString, options);
+    ASSERT_TRUE(fingerprints.insert(std::make_pair(fingerprint.low, fingerprint.high)).second) << uriString;
+  }
+
+  // Many similar URIs, of many lengths, all have different fingerprints.
+  std::set< uint64_t > lows;
+  std::set< uint64_t > highs;
+  for (size_t i = 0; i < 20000; ++i) {
+    const std::string uriString = (
+      "http://example.com/" + std::string(i % 37, 'p')
+      + "?id=" + std::to_string(i)
+    );
+    const auto fingerprint = FingerprintBothWays(uriString, options);
+    ASSERT_TRUE(lows.insert(fingerprint.low).second) << uriString;
+    ASSERT_TRUE(highs.insert(fingerprint.high).second) << uriString;
+  }
+}
+
+TEST(FingerprintTests, SelectedElementsOnly)
+{
+  Uri::FingerprintOptions options;
+  ASSERT_EQ(
+    FingerprintBothWays("http://joe@example.com:81/a?q#f1", options),
+    FingerprintBothWays("https://bob@example.com:82/a?q#f2", options)
+  );
+  ASSERT_NE(
+    FingerprintBothWays("http://example.com/a?q", options),
+    FingerprintBothWays("http://example.com/b?q", options)
+  );
+  options.elements = Uri::FINGERPRINT_HOST;
+  ASSERT_EQ(
+    FingerprintBothWays("http://example.com/a?q", options),
+    FingerprintBothWays("ftp://EXAMPLE.COM/b", options)
+  );
+  options.seed = 1;
+  Uri::FingerprintOptions otherSeed = options;
+  otherSeed.seed = 2;
+  ASSERT_NE(
+    FingerprintBothWays("http://example.com/", options),
+    FingerprintBothWays("http://example.com/", otherSeed)
+  );
+}
+
+TEST(FingerprintTests, QueryParametersInAnyOrderWithExclusions)
+{
+  Uri::FingerprintOptions options;
+  const auto expected = FingerprintBothWays("http://example.com/p?a=1&b=2", options);
+  ASSERT_EQ(expected, FingerprintBothWays("http://example.com/p?b=2&a=1", options));
+  ASSERT_EQ(expected, FingerprintBothWays("http://example.com/p?&b=2&&a=%31&", options));
+  ASSERT_NE(expected, FingerprintBothWays("http://example.com/p?a=2&b=1", options));
+  ASSERT_NE(expected, FingerprintBothWays("http://example.com/p?a=1&b=2&a=1", options));
+  ASSERT_NE(expected, FingerprintBothWays("http://example.com/p?a=1&b=2&utm_source=x", options));
+
+  options.excludeTrackingParameters = true;
+  ASSERT_EQ(expected, FingerprintBothWays("http://example.com/p?utm_source=news&b=2&gclid=7&a=1&utm_medium=email", options));
+  ASSERT_NE(expected, FingerprintBothWays("http://example.com/p?a=1&b=2&utm=x", options));
+  options.excludedParameters = {"session", "b"};
+  ASSERT_EQ(
+    FingerprintBothWays("http://example.com/p?a=1", options),
+    FingerprintBothWays("http://example.com/p?session=42&a=1&b=3", options)
+  );
+
+  options.unorderedQuery = false;
+  ASSERT_NE(
+    FingerprintBothWays("http://example.com/p?a=1&c=2", options),
+    FingerprintBothWays("http://example.com/p?c=2&a=1", options)
+  );
+  ASSERT_EQ(
+    FingerprintBothWays("http://example.com/p?a=1&c=2", options),
+    FingerprintBothWays("http://example.com/p?a=1&b=9&c=2", options)
+  );
+}
+
+TEST(FingerprintTests, InvalidUriHasNoFingerprint)
+{
+  Uri::Fingerprint128 fingerprint;
+  fingerprint.low = 1;
+  ASSERT_FALSE(Uri::Fingerprint("http://exa mple/", 16, Uri::FingerprintOptions(), fingerprint));
+  ASSERT_EQ(1, fingerprint.low);
+}
+
+TEST(FingerprintTests, UrisAsKeysOfUnorderedMap)
+{
+  std::unordered_map< Uri::Uri, int > counts;
+  const std::vector< std::string > uriStrings{
+    "http://example.com/a",
+    "http://example.com/b",
+    "http://example.com/a",
+    "http://example.com/a?x",
+  };
+  for (const auto &uriString : uriStrings) {
+    Uri::Uri uri;
+    ASSERT_TRUE(uri.ParseFromString(uriString));
+    ++counts[uri];
+  }
+  ASSERT_EQ(3, counts.size());
+}
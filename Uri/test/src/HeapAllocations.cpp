@@ -0,0 +1,49 @@
+/**
+ * @file HeapAllocations.cpp
+ *
+ * This module replaces the global operator new and operator delete of
+ * the allocation tests, to count the allocations made from the heap.
+ *
+ * The replacements are kept in a module of their own, which makes no
+ * allocations itself, so that the compiler never sees memory from a
+ * new-expression handed to free, and so that they apply only to the
+ * program which is linked with them.
+ */
+
+#include "HeapAllocations.hpp"
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+namespace {
+/**
+ * This counts the allocations made from the heap by the program.
+ */
+std::atomic< size_t > heapAllocations(0);
+}
+
+size_t GetHeapAllocations()
+{
+  return heapAllocations;
+}
+
+void *operator new(size_t size)
+{
+  ++heapAllocations;
+  void *memory = malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+  free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+  free(memory);
+}
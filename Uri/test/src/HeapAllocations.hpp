@@ -0,0 +1,20 @@
+#ifndef URI_TEST_HEAP_ALLOCATIONS_HPP
+#define URI_TEST_HEAP_ALLOCATIONS_HPP
+
+/**
+ * @file HeapAllocations.hpp
+ *
+ * This module declares the counter of allocations from the heap,
+ * with which the allocation tests check that something doesn't
+ * allocate.
+ */
+
+#include <stddef.h>
+
+/**
+ * This function returns the number of allocations made from the
+ * heap, by the global operator new, since the program started.
+ */
+size_t GetHeapAllocations();
+
+#endif /* URI_TEST_HEAP_ALLOCATIONS_HPP */
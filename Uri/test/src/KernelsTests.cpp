@@ -0,0 +1,177 @@
+/**
+ * @file KernelsTests.cpp
+ *
+ * This module contains the unit tests of the kernel selection
+ * functions of the Uri library.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/Kernels.hpp>
+#include <Uri/PercentEncoding.hpp>
+#include <Uri/UriView.hpp>
+
+#include "Kernels.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * These are all the kernel sets.
+ */
+const std::vector< Uri::KernelSet > allKernelSets {
+  Uri::KernelSet::Scalar,
+  Uri::KernelSet::Sse2,
+  Uri::KernelSet::Avx2,
+  Uri::KernelSet::Avx512,
+};
+
+/**
+ * This parses the given URI and renders what was found,
+ * so that parses done with different kernels can be compared.
+ */
+std::string Describe(const std::string &uriString) {
+  Uri::UriView uri;
+  if (!uri.ParseFromString(uriString)) {
+    return "invalid";
+  }
+  return (
+    uri.GetScheme().ToString() + "|" + uri.GetUserInfo().ToString()
+    + "|" + uri.GetHost().ToString() + "|" + std::to_string(uri.GetPort())
+    + "|" + uri.GetPath().ToString() + "|" + uri.GetQuery().ToString()
+    + "|" + uri.GetFragment().ToString()
+  );
+}
+
+/**
+ * This is the number of characters in the blocks given to the kernels.
+ */
+constexpr size_t BLOCK_SIZE = 64;
+
+/**
+ * This checks that one kernel of each supported kernel set finds the
+ * same characters as the scalar one, in every block made by putting
+ * each character value at each position of a block, among ordinary
+ * characters or among characters of every value.
+ *
+ * @param[in] name
+ *     This is the name of the kernel, for reporting failures.
+ *
+ * @param[in] scan
+ *     This calls the kernel of the given kernel set for
+ *     the given block, and returns the mask it returns.
+ */
+void ExpectKernelsAgree(
+  const char *name,
+  uint64_t (*scan)(const Uri::Kernels &kernels, const char *data)
+) {
+  std::vector< std::string > backgrounds{std::string(BLOCK_SIZE, 'x')};
+  for (size_t phase = 0; phase < 4; ++phase) {
+    std::string background(BLOCK_SIZE, '\0');
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+      background[i] = (char)(i * 4 + phase);
+    }
+    backgrounds.push_back(background);
+  }
+  const auto original = Uri::GetKernelSet();
+  ASSERT_TRUE(Uri::SelectKernelSet(Uri::KernelSet::Scalar));
+  const Uri::Kernels scalar = Uri::GetKernels();
+  for (const auto kernelSet : allKernelSets) {
+    if (!Uri::SelectKernelSet(kernelSet)) {
+      continue;
+    }
+    const Uri::Kernels kernels = Uri::GetKernels();
+    for (auto block : backgrounds) {
+      for (size_t position = 0; position < BLOCK_SIZE; ++position) {
+        const char replaced = block[position];
+        for (unsigned int value = 0; value < 256; ++value) {
+          block[position] = (char)value;
+          ASSERT_EQ(scan(scalar, block.data()), scan(kernels, block.data()))
+            << name << ", " << Uri::GetKernelSetName(kernelSet)
+            << ": character " << value << " at " << position;
+        }
+        block[position] = replaced;
+      }
+    }
+  }
+  ASSERT_TRUE(Uri::SelectKernelSet(original));
+}
+}
+
+TEST(KernelsTests, ScalarKernelsAlwaysSupported)
+{
+  ASSERT_TRUE(Uri::IsKernelSetSupported(Uri::KernelSet::Scalar));
+  ASSERT_STREQ("scalar", Uri::GetKernelSetName(Uri::KernelSet::Scalar));
+  ASSERT_STREQ("avx512", Uri::GetKernelSetName(Uri::KernelSet::Avx512));
+  ASSERT_TRUE(Uri::IsKernelSetSupported(Uri::GetKernelSet()));
+}
+
+TEST(KernelsTests, AllSupportedKernelsAgree)
+{
+  std::vector< std::string > testVector;
+  for (size_t position = 0; position < 150; position += 7) {
+    std::string tail(200, 'x');
+    tail[position] = '/';
+    tail[position / 2] = '#';
+    testVector.push_back("http://joe@www.example.com:8080/" + tail);
+    testVector.push_back("http://www.example.com/?" + tail);
+    tail[position + 1] = '\x7f';
+    testVector.push_back("http://www.example.com/" + tail);
+    tail[position + 1] = '%';
+    testVector.push_back("//" + tail);
+  }
+  const auto original = Uri::GetKernelSet();
+  ASSERT_TRUE(Uri::SelectKernelSet(Uri::KernelSet::Scalar));
+  std::vector< std::string > expected;
+  for (const auto &uriString : testVector) {
+    expected.push_back(Describe(uriString));
+  }
+  for (const auto kernelSet : allKernelSets) {
+    if (!Uri::IsKernelSetSupported(kernelSet)) {
+      ASSERT_FALSE(Uri::SelectKernelSet(kernelSet));
+      continue;
+    }
+    ASSERT_TRUE(Uri::SelectKernelSet(kernelSet));
+    ASSERT_EQ(kernelSet, Uri::GetKernelSet());
+    for (size_t i = 0; i < testVector.size(); ++i) {
+      ASSERT_EQ(expected[i], Describe(testVector[i]))
+        << Uri::GetKernelSetName(kernelSet) << ": " << testVector[i];
+    }
+  }
+  ASSERT_TRUE(Uri::SelectKernelSet(original));
+}
+
+TEST(KernelsTests, AllSupportedKernelsFindTheSameCharacters)
+{
+  ExpectKernelsAgree(
+    "scanDelimiters",
+    [](const Uri::Kernels &kernels, const char *data) {
+      return kernels.scanDelimiters(data);
+    }
+  );
+  ExpectKernelsAgree(
+    "scanPercents",
+    [](const Uri::Kernels &kernels, const char *data) {
+      return kernels.scanPercents(data);
+    }
+  );
+  ExpectKernelsAgree(
+    "scanEscapes, path",
+    [](const Uri::Kernels &kernels, const char *data) {
+      return kernels.scanEscapes(data, Uri::ENCODE_PATH.lowNibbleBits);
+    }
+  );
+  ExpectKernelsAgree(
+    "scanEscapes, query component",
+    [](const Uri::Kernels &kernels, const char *data) {
+      return kernels.scanEscapes(data, Uri::ENCODE_QUERY_COMPONENT.lowNibbleBits);
+    }
+  );
+  ExpectKernelsAgree(
+    "scanQuerySeparators",
+    [](const Uri::Kernels &kernels, const char *data) {
+      return kernels.scanQuerySeparators(data);
+    }
+  );
+}
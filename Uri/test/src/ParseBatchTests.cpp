@@ -0,0 +1,162 @@
+/**
+ * @file ParseBatchTests.cpp
+ *
+ * This module contains the unit tests of the Uri::ParseBatch function.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/ParseBatch.hpp>
+#include <Uri/UriView.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * This holds a batch of URIs laid out as ParseBatch expects them.
+ */
+struct Batch {
+  std::string buffer;
+  std::vector< size_t > offsets{0};
+
+  explicit Batch(const std::vector< std::string > &uriStrings) {
+    for (const auto &uriString : uriStrings) {
+      buffer += uriString;
+      offsets.push_back(buffer.length());
+    }
+  }
+
+  size_t Count() const { return offsets.size() - 1; }
+};
+}
+
+TEST(ParseBatchTests, MatchesParsingOneAtATime)
+{
+  const std::vector< std::string > uriStrings{
+    "http://www.example.com/",
+    "https://joe@www.example.com:8080/foo/bar?q=1#frag",
+    "foo/bar",
+    "",
+    "http://example.com:99999/",
+    "urn:book:fantasy:Hobbit",
+    "//[v7.:]:80",
+    "?",
+    "#",
+    "http://exa mple.com/",
+    "/a/b?c#d?e",
+  };
+  const Batch batch(uriStrings);
+  Uri::BatchResults results;
+  size_t expectedValid = 0;
+  ASSERT_EQ(
+    uriStrings.size() - 2,
+    Uri::ParseBatch(batch.buffer.data(), batch.offsets.data(), batch.Count(), results)
+  );
+  ASSERT_EQ(uriStrings.size(), results.count);
+  for (size_t i = 0; i < uriStrings.size(); ++i) {
+    Uri::UriView uri;
+    const bool valid = uri.ParseFromString(uriStrings[i]);
+    ASSERT_EQ(valid, results.IsValid(i)) << uriStrings[i];
+    if (!valid) {
+      ASSERT_EQ(0, results.flags[i]);
+      ASSERT_EQ(0, results.pathEnd[i]);
+      continue;
+    }
+    ++expectedValid;
+    const auto *characters = batch.buffer.data() + batch.offsets[i];
+    const auto view = [characters](uint32_t begin, uint32_t end) {
+      return Uri::StringView(characters + begin, end - begin);
+    };
+    ASSERT_EQ(uri.GetScheme(), view(0, results.schemeEnd[i])) << uriStrings[i];
+    ASSERT_EQ(uri.GetHost(), view(results.hostBegin[i], results.hostEnd[i])) << uriStrings[i];
+    ASSERT_EQ(uri.GetPath(), view(results.pathBegin[i], results.pathEnd[i])) << uriStrings[i];
+    ASSERT_EQ(uri.GetQuery(), view(results.queryBegin[i], results.queryEnd[i])) << uriStrings[i];
+    ASSERT_EQ(uri.GetFragment(), view(results.fragmentBegin[i], results.fragmentEnd[i])) << uriStrings[i];
+    ASSERT_EQ(uri.HasScheme(), results.Has(i, Uri::BatchResults::HasScheme)) << uriStrings[i];
+    ASSERT_EQ(uri.HasAuthority(), results.Has(i, Uri::BatchResults::HasAuthority)) << uriStrings[i];
+    ASSERT_EQ(uri.HasPort(), results.Has(i, Uri::BatchResults::HasPort)) << uriStrings[i];
+    ASSERT_EQ(uri.GetPort(), results.port[i]) << uriStrings[i];
+    ASSERT_EQ(uri.HasQuery(), results.Has(i, Uri::BatchResults::HasQuery)) << uriStrings[i];
+    ASSERT_EQ(uri.HasFragment(), results.Has(i, Uri::BatchResults::HasFragment)) << uriStrings[i];
+  }
+  ASSERT_EQ(uriStrings.size() - 2, expectedValid);
+}
+
+TEST(ParseBatchTests, ValidityBitmapSpansManyWords)
+{
+  std::vector< std::string > uriStrings;
+  for (size_t i = 0; i < 200; ++i) {
+    uriStrings.push_back((i % 3 == 0) ? "http://bad host/" : "http://host" + std::to_string(i) + "/");
+  }
+  const Batch batch(uriStrings);
+  Uri::BatchResults results;
+  ASSERT_EQ(133, Uri::ParseBatch(batch.buffer.data(), batch.offsets.data(), batch.Count(), results));
+  ASSERT_EQ(4, results.valid.size());
+  for (size_t i = 0; i < uriStrings.size(); ++i) {
+    ASSERT_EQ(i % 3 != 0, results.IsValid(i)) << i;
+  }
+
+  // Reusing the results for a smaller batch leaves no stale bits.
+  const Batch smaller(std::vector< std::string >{"a", "b c", "d"});
+  ASSERT_EQ(2, Uri::ParseBatch(smaller.buffer.data(), smaller.offsets.data(), smaller.Count(), results));
+  ASSERT_EQ(3, results.count);
+  ASSERT_EQ(1, results.valid.size());
+  ASSERT_EQ(0x5, results.valid[0]);
+}
+
+TEST(ParseBatchTests, EmptyBatch)
+{
+  const size_t offsets[] = {0};
+  Uri::BatchResults results;
+  ASSERT_EQ(0, Uri::ParseBatch("", offsets, 0, results));
+  ASSERT_EQ(0, results.count);
+  ASSERT_TRUE(results.valid.empty());
+}
+
+TEST(ParseBatchTests, ParallelMatchesSequential)
+{
+  std::vector< std::string > uriStrings;
+  for (size_t i = 0; i < 5000; ++i) {
+    switch (i % 4) {
+      case 0: uriStrings.push_back("http://host" + std::to_string(i) + ":" + std::to_string(i * 13) + "/p?q#f"); break;
+      case 1: uriStrings.push_back("relative/path/" + std::to_string(i)); break;
+      case 2: uriStrings.push_back("https://example.com:" + std::to_string(i * 29) + "/"); break;
+      default: uriStrings.push_back("bad^" + std::to_string(i)); break;
+    }
+  }
+  const Batch batch(uriStrings);
+  Uri::BatchResults expected;
+  const size_t expectedValid = Uri::ParseBatch(batch.buffer.data(), batch.offsets.data(), batch.Count(), expected);
+  for (const size_t threads : {1, 2, 3, 8}) {
+    for (const size_t grainSize : {0, 1, 64, 100, 4096, 100000}) {
+      Uri::BatchOptions options;
+      options.threads = threads;
+      options.grainSize = grainSize;
+      Uri::BatchResults results;
+      ASSERT_EQ(
+        expectedValid,
+        Uri::ParseBatch(batch.buffer.data(), batch.offsets.data(), batch.Count(), results, options)
+      ) << threads << " threads, grain size " << grainSize;
+      ASSERT_EQ(expected.valid, results.valid);
+      ASSERT_EQ(expected.flags, results.flags);
+      ASSERT_EQ(expected.schemeEnd, results.schemeEnd);
+      ASSERT_EQ(expected.hostBegin, results.hostBegin);
+      ASSERT_EQ(expected.hostEnd, results.hostEnd);
+      ASSERT_EQ(expected.port, results.port);
+      ASSERT_EQ(expected.pathBegin, results.pathBegin);
+      ASSERT_EQ(expected.pathEnd, results.pathEnd);
+      ASSERT_EQ(expected.queryBegin, results.queryBegin);
+      ASSERT_EQ(expected.queryEnd, results.queryEnd);
+      ASSERT_EQ(expected.fragmentBegin, results.fragmentBegin);
+      ASSERT_EQ(expected.fragmentEnd, results.fragmentEnd);
+    }
+  }
+}
+
+TEST(ParseBatchTests, ParallelEmptyBatch)
+{
+  const size_t offsets[] = {0};
+  Uri::BatchResults results;
+  ASSERT_EQ(0, Uri::ParseBatch("", offsets, 0, results, Uri::BatchOptions()));
+  ASSERT_EQ(0, results.count);
+}
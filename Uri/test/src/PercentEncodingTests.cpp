@@ -0,0 +1,289 @@
+/**
+ * @file PercentEncodingTests.cpp
+ *
+ * This module contains the unit tests of the functions which decode
+ * the percent-encoded octets of the elements of a URI.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/Kernels.hpp>
+#include <Uri/PercentEncoding.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * This decodes the given string one character at a time, the obvious
+ * way, so that what the library does can be compared with it.
+ */
+std::string ReferenceDecode(const std::string &encoded) {
+  std::string decoded;
+  for (size_t i = 0; i < encoded.length(); ++i) {
+    if (encoded[i] == '%') {
+      decoded.push_back((char)std::stoi(encoded.substr(i + 1, 2), nullptr, 16));
+      i += 2;
+    } else {
+      decoded.push_back(encoded[i]);
+    }
+  }
+  return decoded;
+}
+
+/**
+ * This decodes the given string with each of the three functions,
+ * checks that they agree, and returns what they decoded.
+ */
+std::string DecodeAllWays(const std::string &encoded, unsigned int options = 0) {
+  std::vector< char > output(encoded.length() + 1);
+  const auto result = Uri::PercentDecode(encoded.data(), encoded.length(), output.data(), options);
+  EXPECT_TRUE(result.IsValid()) << encoded;
+  const std::string decoded(output.data(), result.length);
+
+  std::string buffer = encoded;
+  const auto inPlaceResult = Uri::PercentDecodeInPlace(buffer, options);
+  EXPECT_TRUE(inPlaceResult.IsValid()) << encoded;
+  EXPECT_EQ(decoded, buffer) << encoded;
+
+  std::string scratch;
+  Uri::StringView view;
+  const auto viewResult = Uri::PercentDecodeView(encoded, scratch, view, options);
+  EXPECT_TRUE(viewResult.IsValid()) << encoded;
+  EXPECT_EQ(decoded, view) << encoded;
+  return decoded;
+}
+
+/**
+ * This decodes the given string, which must not decode, with each of
+ * the three functions, checks that they agree on why not and where,
+ * and returns why not and where.
+ */
+Uri::DecodeResult FailAllWays(const std::string &encoded, unsigned int options = 0) {
+  std::vector< char > output(encoded.length() + 1);
+  const auto result = Uri::PercentDecode(encoded.data(), encoded.length(), output.data(), options);
+  EXPECT_FALSE(result.IsValid()) << encoded;
+  EXPECT_EQ(0, result.length) << encoded;
+
+  std::string buffer = encoded;
+  const auto inPlaceResult = Uri::PercentDecodeInPlace(buffer, options);
+  EXPECT_EQ(result.error, inPlaceResult.error) << encoded;
+  EXPECT_EQ(result.errorOffset, inPlaceResult.errorOffset) << encoded;
+  EXPECT_EQ(encoded.length(), buffer.length()) << encoded;
+
+  std::string scratch;
+  Uri::StringView view("unchanged");
+  const auto viewResult = Uri::PercentDecodeView(encoded, scratch, view, options);
+  EXPECT_EQ(result.error, viewResult.error) << encoded;
+  EXPECT_EQ(result.errorOffset, viewResult.errorOffset) << encoded;
+  EXPECT_EQ("unchanged", view) << encoded;
+  return result;
+}
+}
+
+TEST(PercentEncodingTests, DecodeSimple)
+{
+  ASSERT_EQ("", DecodeAllWays(""));
+  ASSERT_EQ("abc", DecodeAllWays("abc"));
+  ASSERT_EQ("a b", DecodeAllWays("a%20b"));
+  ASSERT_EQ("%", DecodeAllWays("%25"));
+  ASSERT_EQ("%41", DecodeAllWays("%2541"));
+  ASSERT_EQ("\xe6\x97\xa5\xe6\x9c\xac", DecodeAllWays("%E6%97%A5%e6%9c%ac"));
+  ASSERT_EQ("a+b", DecodeAllWays("a+b"));
+  ASSERT_EQ(std::string("a\0b", 3), DecodeAllWays("a%00b"));
+  ASSERT_EQ("a/b", DecodeAllWays("a%2Fb"));
+}
+
+TEST(PercentEncodingTests, DecodeWithoutPercentReturnsSameView)
+{
+  const std::string encoded(1000, 'x');
+  std::string scratch;
+  Uri::StringView decoded;
+  ASSERT_TRUE(Uri::PercentDecodeView(encoded, scratch, decoded).IsValid());
+  ASSERT_EQ(encoded.data(), decoded.data());
+  ASSERT_EQ(encoded.length(), decoded.size());
+  ASSERT_TRUE(scratch.empty());
+}
+
+TEST(PercentEncodingTests, DecodeBadPercentEncoding)
+{
+  struct TestVector {
+    std::string encoded;
+    size_t errorOffset;
+  };
+  const std::vector< TestVector > testVectors{
+    {"%", 0},
+    {"%4", 0},
+    {"abc%", 3},
+    {"abc%4", 3},
+    {"a%4g", 1},
+    {"a%g4", 1},
+    {"a%20%2", 4},
+    {"a%%20", 1},
+    {"%20%-1", 3},
+  };
+  for (const auto &testVector : testVectors) {
+    const auto result = FailAllWays(testVector.encoded);
+    ASSERT_EQ(Uri::DecodeError::BadPercentEncoding, result.error) << testVector.encoded;
+    ASSERT_EQ(testVector.errorOffset, result.errorOffset) << testVector.encoded;
+  }
+}
+
+TEST(PercentEncodingTests, DecodeRejectingNulAndSlash)
+{
+  ASSERT_EQ("a/b", DecodeAllWays("a%2fb", Uri::DECODE_REJECT_NUL));
+  ASSERT_EQ(std::string("a\0b", 3), DecodeAllWays("a%00b", Uri::DECODE_REJECT_SLASH));
+  ASSERT_EQ("a b", DecodeAllWays("a%20b", Uri::DECODE_REJECT_NUL | Uri::DECODE_REJECT_SLASH));
+
+  auto result = FailAllWays("ab%00", Uri::DECODE_REJECT_NUL);
+  ASSERT_EQ(Uri::DecodeError::DecodedNul, result.error);
+  ASSERT_EQ(2, result.errorOffset);
+  result = FailAllWays("..%2F..%2fetc", Uri::DECODE_REJECT_SLASH);
+  ASSERT_EQ(Uri::DecodeError::DecodedSlash, result.error);
+  ASSERT_EQ(2, result.errorOffset);
+  result = FailAllWays("%2F%00", Uri::DECODE_REJECT_NUL | Uri::DECODE_REJECT_SLASH);
+  ASSERT_EQ(Uri::DecodeError::DecodedSlash, result.error);
+  ASSERT_EQ(0, result.errorOffset);
+}
+
+TEST(PercentEncodingTests, DecodePlusAsSpace)
+{
+  ASSERT_EQ("a b", DecodeAllWays("a+b", Uri::DECODE_PLUS_AS_SPACE));
+  ASSERT_EQ("  ", DecodeAllWays("++", Uri::DECODE_PLUS_AS_SPACE));
+  ASSERT_EQ("a+b c", DecodeAllWays("a%2Bb+c", Uri::DECODE_PLUS_AS_SPACE));
+  ASSERT_EQ(" a b!c ", DecodeAllWays("+a+b%21c+", Uri::DECODE_PLUS_AS_SPACE));
+  ASSERT_EQ("a+b", DecodeAllWays("a+b"));
+
+  // A view of characters with a "+" but no "%" needs decoding too.
+  const std::string encoded = "hello+world";
+  std::string scratch;
+  Uri::StringView decoded;
+  ASSERT_TRUE(Uri::PercentDecodeView(encoded, scratch, decoded, Uri::DECODE_PLUS_AS_SPACE).IsValid());
+  ASSERT_EQ("hello world", decoded);
+  ASSERT_EQ("hello+world", encoded);
+}
+
+TEST(PercentEncodingTests, DecodeWithEveryKernelSet)
+{
+  // Percent-encoded octets at every position across several blocks,
+  // including straddling the ends of blocks, in sparse and dense runs.
+  std::vector< std::string > testVector;
+  for (size_t position = 0; position < 200; position += 3) {
+    std::string encoded(250, 'x');
+    encoded.replace(position, 3, "%41");
+    testVector.push_back(encoded);
+    std::string dense = encoded.substr(0, position);
+    for (size_t i = 0; i < 40; ++i) {
+      dense += "%" + std::string(1, "0123456789ABCDEF"[i % 16]) + "f";
+    }
+    testVector.push_back(dense + std::string(position, 'y'));
+  }
+  const auto original = Uri::GetKernelSet();
+  for (const auto kernelSet : {Uri::KernelSet::Scalar, Uri::KernelSet::Sse2, Uri::KernelSet::Avx2, Uri::KernelSet::Avx512}) {
+    if (!Uri::SelectKernelSet(kernelSet)) {
+      continue;
+    }
+    for (const auto &encoded : testVector) {
+      ASSERT_EQ(ReferenceDecode(encoded), DecodeAllWays(encoded))
+        << Uri::GetKernelSetName(kernelSet) << ": " << encoded;
+    }
+    for (size_t position = 0; position < 200; position += 5) {
+      std::string encoded(250, 'x');
+      encoded.replace(position, 3, "%4z");
+      const auto result = FailAllWays(encoded);
+      ASSERT_EQ(Uri::DecodeError::BadPercentEncoding, result.error);
+      ASSERT_EQ(position, result.errorOffset) << Uri::GetKernelSetName(kernelSet);
+    }
+  }
+  ASSERT_TRUE(Uri::SelectKernelSet(original));
+}
+
+TEST(PercentEncodingTests, EncodeEachElement)
+{
+  const std::string decoded = "a b/c?d#e&f=g+h;i@j:k%l\xc3\xa9~";
+  ASSERT_EQ(
+    "a%20b%2Fc%3Fd%23e&f=g+h;i%40j:k%25l%C3%A9~",
+    Uri::PercentEncode(decoded, Uri::ENCODE_USER_INFO)
+  );
+  ASSERT_EQ(
+    "a%20b%2Fc%3Fd%23e&f=g+h;i@j:k%25l%C3%A9~",
+    Uri::PercentEncode(decoded, Uri::ENCODE_PATH_SEGMENT)
+  );
+  ASSERT_EQ(
+    "a%20b/c%3Fd%23e&f=g+h;i@j:k%25l%C3%A9~",
+    Uri::PercentEncode(decoded, Uri::ENCODE_PATH)
+  );
+  ASSERT_EQ(
+    "a%20b/c?d%23e%26f%3Dg%2Bh%3Bi@j:k%25l%C3%A9~",
+    Uri::PercentEncode(decoded, Uri::ENCODE_QUERY_COMPONENT)
+  );
+  ASSERT_EQ(
+    "a%20b/c?d%23e&f=g+h;i@j:k%25l%C3%A9~",
+    Uri::PercentEncode(decoded, Uri::ENCODE_FRAGMENT)
+  );
+  ASSERT_EQ("", Uri::PercentEncode("", Uri::ENCODE_PATH));
+}
+
+TEST(PercentEncodingTests, EncodeSetsAgreeWithCharacterClasses)
+{
+  for (unsigned int c = 0; c < 256; ++c) {
+    ASSERT_EQ(
+      (c < 0x80) && ((Uri::CharacterClasses::GetClasses((char)c) & Uri::CharacterClasses::PCHAR) != 0),
+      Uri::ENCODE_PATH_SEGMENT.Allows((char)c)
+    ) << c;
+    ASSERT_EQ(Uri::ENCODE_PATH_SEGMENT.Allows((char)c) || (c == '/'), Uri::ENCODE_PATH.Allows((char)c)) << c;
+  }
+}
+
+TEST(PercentEncodingTests, EncodeWithCustomSet)
+{
+  struct Digits {
+    static constexpr bool Allows(unsigned int c) {
+      return (c >= '0') && (c <= '9');
+    }
+  };
+  constexpr Uri::EncodeSet digits = Uri::MakeEncodeSet(Digits::Allows);
+  static_assert(digits.Allows('5') && !digits.Allows('a'), "built at compile time");
+  ASSERT_EQ("12%2D34%61", Uri::PercentEncode("12-34a", digits));
+}
+
+TEST(PercentEncodingTests, EncodeWithEveryKernelSet)
+{
+  // Every character, at every position across several blocks,
+  // in sparse and dense runs of characters needing encoding.
+  std::vector< std::string > testVector;
+  for (size_t position = 0; position < 200; position += 3) {
+    std::string decoded(250, 'x');
+    decoded[position] = (char)(position + 37);
+    testVector.push_back(decoded);
+  }
+  std::string everyCharacter;
+  for (unsigned int c = 0; c < 256; ++c) {
+    everyCharacter.push_back((char)c);
+  }
+  testVector.push_back(everyCharacter + everyCharacter);
+  const auto original = Uri::GetKernelSet();
+  for (const auto kernelSet : {Uri::KernelSet::Scalar, Uri::KernelSet::Sse2, Uri::KernelSet::Avx2, Uri::KernelSet::Avx512}) {
+    if (!Uri::SelectKernelSet(kernelSet)) {
+      continue;
+    }
+    for (const auto &decoded : testVector) {
+      for (const auto &encodeSet : {Uri::ENCODE_PATH, Uri::ENCODE_QUERY_COMPONENT}) {
+        std::string expected;
+        for (const auto c : decoded) {
+          if (encodeSet.Allows(c)) {
+            expected.push_back(c);
+          } else {
+            expected += "%" + std::string(1, "0123456789ABCDEF"[(unsigned char)c >> 4])
+              + std::string(1, "0123456789ABCDEF"[c & 0x0F]);
+          }
+        }
+        ASSERT_EQ(expected.length(), Uri::PercentEncodedLength(decoded.data(), decoded.length(), encodeSet))
+          << Uri::GetKernelSetName(kernelSet);
+        const auto encoded = Uri::PercentEncode(decoded, encodeSet);
+        ASSERT_EQ(expected, encoded) << Uri::GetKernelSetName(kernelSet);
+        ASSERT_EQ(decoded, DecodeAllWays(encoded)) << Uri::GetKernelSetName(kernelSet);
+      }
+    }
+  }
+  ASSERT_TRUE(Uri::SelectKernelSet(original));
+}
@@ -0,0 +1,179 @@
+/**
+ * @file QueryKeySetTests.cpp
+ *
+ * This module contains the unit tests of the Uri::QueryKeySet
+ * class template.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/QueryKeySet.hpp>
+#include <Uri/Uri.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * These are the keys an analytics pipeline picks out of every URL.
+ */
+struct CampaignKeys {
+  static constexpr const char *keys[] = {
+    "utm_source", "utm_medium", "utm_campaign", "utm_term", "utm_content",
+    "utm_id", "gclid", "fbclid", "msclkid", "sid", "session_id", "ref",
+  };
+};
+using CampaignKeySet = Uri::QueryKeySet< CampaignKeys >;
+
+/**
+ * These are keys which hash alike in all but the characters
+ * in their middles.
+ */
+struct LongKeys {
+  static constexpr const char *keys[] = {
+    "prefix_prefix_a_suffix_suffix",
+    "prefix_prefix_b_suffix_suffix",
+    "prefix_prefix_c_suffix_suffix",
+  };
+};
+
+/**
+ * This is the most keys a set can have.
+ */
+struct ManyKeys {
+  static constexpr const char *keys[] = {
+    "k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7",
+    "k8", "k9", "k10", "k11", "k12", "k13", "k14", "k15",
+    "k16", "k17", "k18", "k19", "k20", "k21", "k22", "k23",
+    "k24", "k25", "k26", "k27", "k28", "k29", "k30", "k31",
+  };
+};
+
+/**
+ * This is a set of only one key.
+ */
+struct OneKey {
+  static constexpr const char *keys[] = {"q"};
+};
+
+/**
+ * This renders the values found for a key set, with "-" for keys
+ * which weren't found, so that they can be compared with
+ * what's expected.
+ */
+template< typename KeySet >
+std::vector< std::string > Describe(const typename KeySet::Values &values) {
+  std::vector< std::string > described;
+  for (size_t i = 0; i < KeySet::NUM_KEYS; ++i) {
+    described.push_back(values.Has(i) ? values[i].ToString() : "-");
+  }
+  return described;
+}
+}
+
+TEST(QueryKeySetTests, ExtractKeysOfSet)
+{
+  struct TestVector {
+    std::string query;
+    std::vector< std::string > expectedValues;
+  };
+  const std::vector< TestVector > testVectors{
+    {"", {"-", "-", "-", "-", "-", "-", "-", "-", "-", "-", "-", "-"}},
+    {
+      "utm_source=news&utm_medium=email&utm_campaign=spring&gclid=abc",
+      {"news", "email", "spring", "-", "-", "-", "abc", "-", "-", "-", "-", "-"}
+    },
+    {
+      "page=3&ref=home&lang=en&sid=42&q=shoes",
+      {"-", "-", "-", "-", "-", "-", "-", "-", "-", "42", "-", "home"}
+    },
+    {
+      "utm_source=first&utm_source=second",
+      {"first", "-", "-", "-", "-", "-", "-", "-", "-", "-", "-", "-"}
+    },
+    {
+      "utm_term&utm_id=",
+      {"-", "-", "-", "", "-", "", "-", "-", "-", "-", "-", "-"}
+    },
+    {
+      "utm_sourc=1&utm_sources=2&UTM_SOURCE=3&utm%5Fsource=4&=5",
+      {"-", "-", "-", "-", "-", "-", "-", "-", "-", "-", "-", "-"}
+    },
+    {
+      "utm_source=a&utm_medium=b&utm_campaign=c&utm_term=d&utm_content=e&utm_id=f"
+      "&gclid=g&fbclid=h&msclkid=i&sid=j&session_id=k&ref=l&utm_source=m",
+      {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l"}
+    },
+  };
+  for (const auto &testVector : testVectors) {
+    const auto values = CampaignKeySet::Extract(testVector.query);
+    ASSERT_EQ(testVector.expectedValues, Describe< CampaignKeySet >(values)) << testVector.query;
+  }
+}
+
+TEST(QueryKeySetTests, ValuesAreViewsOfQuery)
+{
+  const std::string query = "x=1&gclid=abc%20def";
+  const auto values = CampaignKeySet::Extract(query);
+  const auto gclid = CampaignKeySet::IndexOf("gclid");
+  ASSERT_TRUE(values.Has(gclid));
+  ASSERT_EQ(query.data() + 10, values[gclid].data());
+  ASSERT_EQ("abc%20def", values[gclid]);
+}
+
+TEST(QueryKeySetTests, KeysAreNumberedAtCompileTime)
+{
+  static_assert(CampaignKeySet::NUM_KEYS == 12, "");
+  static_assert(CampaignKeySet::IndexOf("utm_source") == 0, "");
+  static_assert(CampaignKeySet::IndexOf("ref") == 11, "");
+  static_assert(CampaignKeySet::IndexOf("page") == CampaignKeySet::NUM_KEYS, "");
+}
+
+TEST(QueryKeySetTests, KeysWhichDifferOnlyInTheMiddle)
+{
+  using KeySet = Uri::QueryKeySet< LongKeys >;
+  const auto values = KeySet::Extract(
+    "prefix_prefix_c_suffix_suffix=3&prefix_prefix_d_suffix_suffix=4&prefix_prefix_a_suffix_suffix=1"
+  );
+  ASSERT_EQ((std::vector< std::string >{"1", "-", "3"}), Describe< KeySet >(values));
+}
+
+TEST(QueryKeySetTests, LargestAndSmallestSets)
+{
+  using ManyKeySet = Uri::QueryKeySet< ManyKeys >;
+  std::string query;
+  std::vector< std::string > expectedValues;
+  for (size_t i = 0; i < 32; ++i) {
+    query += "k" + std::to_string(i) + "=" + std::to_string(i * 3) + "&";
+    expectedValues.push_back(std::to_string(i * 3));
+  }
+  query += "k32=96";
+  ASSERT_EQ(expectedValues, Describe< ManyKeySet >(ManyKeySet::Extract(query)));
+
+  using OneKeySet = Uri::QueryKeySet< OneKey >;
+  ASSERT_EQ((std::vector< std::string >{"shoes"}), Describe< OneKeySet >(OneKeySet::Extract("a=1&q=shoes")));
+  ASSERT_EQ((std::vector< std::string >{"-"}), Describe< OneKeySet >(OneKeySet::Extract("a=1&qq=shoes")));
+}
+
+TEST(QueryKeySetTests, HashIsSameAtCompileTimeAndRunTime)
+{
+  const std::string characters = "abcdefghijklmnopqrstuvwxyz0123456789";
+  for (size_t length = 0; length <= characters.length(); ++length) {
+    const auto key = characters.substr(0, length);
+    for (uint64_t seed = 0; seed < 3; ++seed) {
+      ASSERT_EQ(
+        Uri::QueryKeyHash::HashConstant(key.c_str(), seed),
+        Uri::QueryKeyHash::Hash(key, seed)
+      ) << key;
+    }
+  }
+}
+
+TEST(QueryKeySetTests, ExtractFromQueryOfUri)
+{
+  Uri::Uri uri;
+  ASSERT_TRUE(uri.ParseFromString("https://shop.example.com/p/1?utm_medium=cpc&color=red&fbclid=xyz#reviews"));
+  const auto values = CampaignKeySet::Extract(uri.GetQuery());
+  ASSERT_EQ("cpc", values[CampaignKeySet::IndexOf("utm_medium")]);
+  ASSERT_EQ("xyz", values[CampaignKeySet::IndexOf("fbclid")]);
+  ASSERT_FALSE(values.Has(CampaignKeySet::IndexOf("utm_source")));
+}
@@ -0,0 +1,178 @@
+/**
+ * @file QueryParametersTests.cpp
+ *
+ * This module contains the unit tests of the Uri::QueryParameters
+ * class.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/Kernels.hpp>
+#include <Uri/QueryParameters.hpp>
+#include <Uri/Uri.hpp>
+#include <Uri/UriView.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * This renders the parameters of the given query, so that they can
+ * be compared with what's expected.
+ */
+std::vector< std::string > Describe(const Uri::QueryParameters &parameters) {
+  std::vector< std::string > described;
+  for (const auto &parameter : parameters) {
+    described.push_back(
+      parameter.key.ToString()
+      + (parameter.hasValue ? "=" + parameter.value.ToString() : "")
+    );
+  }
+  return described;
+}
+
+/**
+ * This splits the given query the obvious way, so that what the
+ * library does can be compared with it.
+ */
+std::vector< std::string > ReferenceSplit(const std::string &query) {
+  std::vector< std::string > described;
+  size_t begin = 0;
+  while (begin < query.length()) {
+    auto end = query.find('&', begin);
+    if (end == std::string::npos) {
+      end = query.length();
+    }
+    if (end > begin) {
+      described.push_back(query.substr(begin, end - begin));
+    }
+    begin = end + 1;
+  }
+  return described;
+}
+}
+
+TEST(QueryParametersTests, SplitKeysAndValues)
+{
+  struct TestVector {
+    std::string query;
+    std::vector< std::string > expectedParameters;
+  };
+  const std::vector< TestVector > testVectors{
+    {"", {}},
+    {"&", {}},
+    {"&&&", {}},
+    {"a", {"a"}},
+    {"a=1", {"a=1"}},
+    {"a=1&b=2", {"a=1", "b=2"}},
+    {"a=&b", {"a=", "b"}},
+    {"=1", {"=1"}},
+    {"=", {"="}},
+    {"a&&b&", {"a", "b"}},
+    {"&a", {"a"}},
+    {"k=v=w&x==y", {"k=v=w", "x==y"}},
+  };
+  for (const auto &testVector : testVectors) {
+    const Uri::QueryParameters parameters{Uri::StringView(testVector.query)};
+    ASSERT_EQ(testVector.expectedParameters, Describe(parameters)) << testVector.query;
+    ASSERT_EQ(testVector.expectedParameters.empty(), parameters.empty()) << testVector.query;
+  }
+}
+
+TEST(QueryParametersTests, KeysAndValuesAreViewsOfQuery)
+{
+  const std::string query = "lang=en&flag&page=3";
+  const Uri::QueryParameters parameters{Uri::StringView(query)};
+  auto parameter = parameters.begin();
+  ASSERT_EQ("lang", parameter->key);
+  ASSERT_EQ(query.data(), parameter->key.data());
+  ASSERT_EQ("en", parameter->value);
+  ASSERT_EQ(query.data() + 5, parameter->value.data());
+  ASSERT_TRUE(parameter->hasValue);
+  ++parameter;
+  ASSERT_EQ("flag", parameter->key);
+  ASSERT_TRUE(parameter->value.empty());
+  ASSERT_FALSE(parameter->hasValue);
+  const auto third = ++parameter;
+  ASSERT_EQ("page", parameter++->key);
+  ASSERT_EQ("3", third->value);
+  ASSERT_TRUE(parameter == parameters.end());
+}
+
+TEST(QueryParametersTests, DecodeKeysAndValues)
+{
+  const std::string query = "q=hello+world%21&x%2By=1%2B1&plain=text";
+  const Uri::QueryParameters parameters{Uri::StringView(query)};
+  std::vector< std::string > keys, values, rawValues;
+  for (const auto &parameter : parameters) {
+    std::string scratch;
+    Uri::StringView decoded;
+    ASSERT_TRUE(parameter.DecodeKey(scratch, decoded).IsValid());
+    keys.push_back(decoded);
+    ASSERT_TRUE(parameter.DecodeValue(scratch, decoded).IsValid());
+    values.push_back(decoded);
+    ASSERT_TRUE(parameter.DecodeValue(scratch, decoded, 0).IsValid());
+    rawValues.push_back(decoded);
+  }
+  ASSERT_EQ((std::vector< std::string >{"q", "x+y", "plain"}), keys);
+  ASSERT_EQ((std::vector< std::string >{"hello world!", "1+1", "text"}), values);
+  ASSERT_EQ((std::vector< std::string >{"hello+world!", "1+1", "text"}), rawValues);
+
+  // Nothing is copied for what doesn't need decoding.
+  const auto last = *std::next(parameters.begin(), 2);
+  std::string scratch;
+  Uri::StringView decoded;
+  ASSERT_TRUE(last.DecodeValue(scratch, decoded).IsValid());
+  ASSERT_EQ(last.value.data(), decoded.data());
+
+  // Bad percent-encoding is reported, not decoded.
+  const std::string badQuery = "a=%zz";
+  const Uri::QueryParameters badParameters{Uri::StringView(badQuery)};
+  ASSERT_EQ(
+    Uri::DecodeError::BadPercentEncoding,
+    badParameters.begin()->DecodeValue(scratch, decoded).error
+  );
+}
+
+TEST(QueryParametersTests, ParametersOfUri)
+{
+  Uri::Uri uri;
+  ASSERT_TRUE(uri.ParseFromString("http://www.example.com/search?q=uri&lang=en#top"));
+  ASSERT_EQ((std::vector< std::string >{"q=uri", "lang=en"}), Describe(uri.GetQueryParameters()));
+  ASSERT_TRUE(uri.ParseFromString("http://www.example.com/"));
+  ASSERT_TRUE(uri.GetQueryParameters().empty());
+
+  const std::string uriViewString = "?a=1&b";
+  Uri::UriView uriView;
+  ASSERT_TRUE(uriView.ParseFromString(uriViewString));
+  ASSERT_EQ((std::vector< std::string >{"a=1", "b"}), Describe(uriView.GetQueryParameters()));
+}
+
+TEST(QueryParametersTests, SplitWithEveryKernelSet)
+{
+  // Separators at every position across several blocks, including
+  // straddling the ends of blocks, in sparse and dense runs.
+  std::vector< std::string > testVector;
+  for (size_t position = 0; position < 200; position += 3) {
+    std::string query(250, 'x');
+    query[position] = '&';
+    query[(position * 7) % 250] = '=';
+    query[position / 2] = '&';
+    testVector.push_back(query);
+    std::string dense = query.substr(0, position);
+    for (size_t i = 0; i < 40; ++i) {
+      dense += (i % 3 == 0) ? "k=v&" : ((i % 3 == 1) ? "&=" : "==&");
+    }
+    testVector.push_back(dense + std::string(position, 'y'));
+  }
+  const auto original = Uri::GetKernelSet();
+  for (const auto kernelSet : {Uri::KernelSet::Scalar, Uri::KernelSet::Sse2, Uri::KernelSet::Avx2, Uri::KernelSet::Avx512}) {
+    if (!Uri::SelectKernelSet(kernelSet)) {
+      continue;
+    }
+    for (const auto &query : testVector) {
+      ASSERT_EQ(ReferenceSplit(query), Describe(Uri::QueryParameters(Uri::StringView(query))))
+        << Uri::GetKernelSetName(kernelSet) << ": " << query;
+    }
+  }
+  ASSERT_TRUE(Uri::SelectKernelSet(original));
+}
@@ -0,0 +1,947 @@
+/**
+ * @file UriBenchmarks.cpp
+ *
+ * This module contains the benchmarks of the Uri library.
+ *
+ * Run the program with no arguments to run every benchmark,
+ * or give the names of the benchmarks to run.
+ */
+
+#include <Uri/BaseResolver.hpp>
+#include <Uri/Fingerprint.hpp>
+#include <Uri/Kernels.hpp>
+#include <Uri/ParseBatch.hpp>
+#include <Uri/PercentEncoding.hpp>
+#include <Uri/QueryKeySet.hpp>
+#include <Uri/QueryParameters.hpp>
+#include <Uri/Uri.hpp>
+#include <Uri/Validate.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stddef.h>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+/**
+ * This is used to keep the optimizer from discarding work
+ * whose result is otherwise unused.
+ */
+volatile size_t sink;
+
+/**
+ * This function measures the given work, repeating it until
+ * enough time has passed to get a stable measurement.
+ *
+ * @param[in] work
+ *     This is the work to measure.
+ *
+ * @return
+ *     The best observed time, in nanoseconds, to do the work
+ *     once is returned.
+ */
+double MeasureNanoseconds(const std::function< void() >& work) {
+    using Clock = std::chrono::steady_clock;
+    double best = 0.0;
+    for (int round = 0; round < 5; ++round) {
+        size_t iterations = 0;
+        const auto start = Clock::now();
+        auto now = start;
+        do {
+            work();
+            ++iterations;
+            now = Clock::now();
+        } while (now - start < std::chrono::milliseconds(20));
+        const double perIteration = (
+            std::chrono::duration< double, std::nano >(now - start).count()
+            / (double)iterations
+        );
+        if ((round == 0) || (perIteration < best)) {
+            best = perIteration;
+        }
+    }
+    return best;
+}
+
+/**
+ * This benchmark parses URIs whose paths are made of more and more
+ * single-character segments, and reports the cost per byte, which
+ * should stay flat as the number of segments grows.
+ */
+void BenchmarkPathSegments() {
+    printf("%10s %10s %14s %10s\n", "segments", "bytes", "ns/parse", "ns/byte");
+    Uri::Uri uri;
+    for (size_t segments = 64; segments <= 32768; segments *= 4) {
+        std::string uriString = "http://www.example.com";
+        for (size_t i = 0; i < segments; ++i) {
+            uriString += "/a";
+        }
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                (void)uri.ParseFromString(uriString);
+                sink = uri.GetPath().size();
+            }
+        );
+        printf(
+            "%10zu %10zu %14.0f %10.2f\n",
+            segments,
+            uriString.length(),
+            nanoseconds,
+            nanoseconds / (double)uriString.length()
+        );
+    }
+}
+
+/**
+ * This benchmark parses URIs with long query strings made of many
+ * key-value pairs, and reports the parse throughput.
+ */
+void BenchmarkLongQuery() {
+    printf("%10s %14s %10s\n", "bytes", "ns/parse", "GB/s");
+    Uri::Uri uri;
+    for (size_t pairs = 4; pairs <= 256; pairs *= 4) {
+        std::string uriString = "http://ads.example.com/track?";
+        for (size_t i = 0; i < pairs; ++i) {
+            if (i > 0) {
+                uriString += "&";
+            }
+            uriString += "param" + std::to_string(i) + "=value_with-some.length~" + std::to_string(i * 7919);
+        }
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                (void)uri.ParseFromString(uriString);
+                sink = uri.GetQuery().size();
+            }
+        );
+        printf(
+            "%10zu %14.0f %10.2f\n",
+            uriString.length(),
+            nanoseconds,
+            (double)uriString.length() / nanoseconds
+        );
+    }
+}
+
+/**
+ * This benchmark constructs a fresh URI for each of a handful of
+ * typical URIs and parses it, which is what code handling one URI
+ * at a time does, so the cost of making the URI counts.
+ */
+void BenchmarkConstructAndParse() {
+    printf("%10s %14s\n", "bytes", "ns/parse");
+    const char* const uriStrings[] = {
+        "http://www.example.com/",
+        "https://joe@www.example.com:8080/docs/guide/index.html?lang=en#install",
+        "/search?q=uniform+resource+identifier&page=2",
+    };
+    for (const auto uriString: uriStrings) {
+        const std::string input(uriString);
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                Uri::Uri uri;
+                (void)uri.ParseFromString(input);
+                sink = uri.GetHost().size();
+            }
+        );
+        printf("%10zu %14.1f\n", input.length(), nanoseconds);
+    }
+}
+
+/**
+ * This function makes a batch of URIs like those found in access logs
+ * and crawl queues, laid out one after another in the given buffer,
+ * with their offsets in the given array.
+ */
+void MakeLogBatch(
+    size_t count,
+    std::string& buffer,
+    std::vector< size_t >& offsets
+) {
+    const char* const hosts[] = {"www.example.com", "cdn.example.net:8443", "api.example.org"};
+    const char* const paths[] = {"/", "/index.html", "/static/js/app.min.js", "/v1/users/12345/orders"};
+    buffer.clear();
+    offsets.assign(1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        buffer += (i % 5 == 0) ? "http://" : "https://";
+        buffer += hosts[i % 3];
+        buffer += paths[i % 4];
+        if (i % 2 == 0) {
+            buffer += "?id=" + std::to_string(i) + "&ref=home";
+        }
+        if (i % 7 == 0) {
+            buffer += "#top";
+        }
+        offsets.push_back(buffer.length());
+    }
+}
+
+/**
+ * This benchmark parses a batch of URIs, both with ParseBatch and
+ * by calling ParseFromString on each one, and reports the throughput
+ * of each in millions of URIs per second.
+ */
+void BenchmarkBatch() {
+    printf("%10s %16s %16s\n", "URIs", "ParseBatch M/s", "loop M/s");
+    std::string buffer;
+    std::vector< size_t > offsets;
+    Uri::BatchResults results;
+    for (size_t count = 1000; count <= 100000; count *= 10) {
+        MakeLogBatch(count, buffer, offsets);
+        std::vector< std::string > uriStrings;
+        for (size_t i = 0; i < count; ++i) {
+            uriStrings.emplace_back(buffer, offsets[i], offsets[i + 1] - offsets[i]);
+        }
+        const double batchNanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = Uri::ParseBatch(buffer.data(), offsets.data(), count, results);
+            }
+        );
+        Uri::Uri uri;
+        const double loopNanoseconds = MeasureNanoseconds(
+            [&]{
+                size_t numValid = 0;
+                for (const auto& uriString: uriStrings) {
+                    numValid += uri.ParseFromString(uriString) ? 1 : 0;
+                }
+                sink = numValid;
+            }
+        );
+        printf(
+            "%10zu %16.2f %16.2f\n",
+            count,
+            (double)count * 1000.0 / batchNanoseconds,
+            (double)count * 1000.0 / loopNanoseconds
+        );
+    }
+}
+
+/**
+ * This benchmark parses a large batch of URIs on more and more
+ * threads, and reports the throughput for each number of threads,
+ * along with how close it comes to scaling linearly.
+ */
+void BenchmarkParallelBatch() {
+    printf("%10s %16s %10s\n", "threads", "M URIs/s", "speedup");
+    const size_t count = 1000000;
+    std::string buffer;
+    std::vector< size_t > offsets;
+    MakeLogBatch(count, buffer, offsets);
+    Uri::BatchResults results;
+    const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    double baseline = 0.0;
+    for (size_t threads = 1; ; threads *= 2) {
+        if (threads > hardwareThreads) {
+            threads = hardwareThreads;
+        }
+        Uri::BatchOptions options;
+        options.threads = threads;
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = Uri::ParseBatch(buffer.data(), offsets.data(), count, results, options);
+            }
+        );
+        const double throughput = (double)count * 1000.0 / nanoseconds;
+        if (threads == 1) {
+            baseline = throughput;
+        }
+        printf("%10zu %16.2f %10.2f\n", threads, throughput, throughput / baseline);
+        if (threads >= hardwareThreads) {
+            break;
+        }
+    }
+}
+
+/**
+ * This benchmark checks URIs with Validate, both a batch of short
+ * ones like those found in access logs and single long ones, and
+ * reports the throughput.
+ */
+void BenchmarkValidate() {
+    printf("%20s %10s %10s\n", "input", "bytes", "GB/s");
+    std::string buffer;
+    std::vector< size_t > offsets;
+    const size_t count = 10000;
+    MakeLogBatch(count, buffer, offsets);
+    double nanoseconds = MeasureNanoseconds(
+        [&]{
+            size_t numValid = 0;
+            for (size_t i = 0; i < count; ++i) {
+                numValid += Uri::IsValid(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]) ? 1 : 0;
+            }
+            sink = numValid;
+        }
+    );
+    printf("%20s %10zu %10.2f\n", "log URIs", buffer.length(), (double)buffer.length() / nanoseconds);
+    for (size_t length = 1024; length <= 1024 * 1024; length *= 32) {
+        std::string uriString = "http://ads.example.com/track?";
+        while (uriString.length() < length) {
+            uriString += "param=value_with-some.length~12345&";
+        }
+        nanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = Uri::Validate(uriString).errorOffset;
+            }
+        );
+        printf("%20s %10zu %10.2f\n", "long query", uriString.length(), (double)uriString.length() / nanoseconds);
+    }
+}
+
+/**
+ * This function decodes the given characters one at a time, the way
+ * code without a decoding facility typically does, to compare with.
+ */
+size_t NaivePercentDecode(const std::string& encoded, char* output) {
+    size_t written = 0;
+    for (size_t i = 0; i < encoded.length(); ++i) {
+        if ((encoded[i] == '%') && (i + 2 < encoded.length())) {
+            output[written++] = (char)strtol(encoded.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else {
+            output[written++] = encoded[i];
+        }
+    }
+    return written;
+}
+
+/**
+ * This benchmark percent-decodes 64 KiB of characters with more and
+ * fewer percent-encoded octets in them, and reports the throughput,
+ * compared with decoding them one character at a time.
+ */
+void BenchmarkPercentDecode() {
+    printf("%14s %12s %12s %12s\n", "one % every", "GB/s", "in place", "naive GB/s");
+    const size_t length = 65536;
+    for (size_t spacing = 3; spacing <= 4096; spacing *= 4) {
+        std::string encoded;
+        while (encoded.length() < length) {
+            encoded += "%2F";
+            encoded += std::string(spacing - 3, 'a');
+        }
+        std::vector< char > output(encoded.length());
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = Uri::PercentDecode(encoded.data(), encoded.length(), output.data()).length;
+            }
+        );
+        std::string buffer;
+        const double inPlaceNanoseconds = MeasureNanoseconds(
+            [&]{
+                buffer = encoded;
+                sink = Uri::PercentDecodeInPlace(buffer).length;
+            }
+        );
+        const double naiveNanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = NaivePercentDecode(encoded, output.data());
+            }
+        );
+        printf(
+            "%14zu %12.2f %12.2f %12.2f\n",
+            spacing,
+            (double)encoded.length() / nanoseconds,
+            (double)encoded.length() / inPlaceNanoseconds,
+            (double)encoded.length() / naiveNanoseconds
+        );
+    }
+}
+
+/**
+ * This function percent-encodes the given characters one at a time,
+ * growing the string as it goes, the way code without an encoding
+ * facility typically does, to compare with.
+ */
+std::string NaivePercentEncode(const std::string& decoded) {
+    std::string encoded;
+    for (const auto c : decoded) {
+        if (Uri::ENCODE_PATH.Allows(c)) {
+            encoded.push_back(c);
+        } else {
+            char escape[4];
+            snprintf(escape, sizeof(escape), "%%%02X", (unsigned char)c);
+            encoded += escape;
+        }
+    }
+    return encoded;
+}
+
+/**
+ * This benchmark percent-encodes 64 KiB of characters with more and
+ * fewer characters needing encoding in them, and reports the
+ * throughput, compared with encoding them one character at a time.
+ */
+void BenchmarkPercentEncode() {
+    printf("%14s %12s %12s\n", "one ' ' every", "GB/s", "naive GB/s");
+    const size_t length = 65536;
+    for (size_t spacing = 1; spacing <= 4096; spacing *= 4) {
+        std::string decoded;
+        while (decoded.length() < length) {
+            decoded += " ";
+            decoded += std::string(spacing - 1, 'a');
+        }
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = Uri::PercentEncode(decoded, Uri::ENCODE_PATH).length();
+            }
+        );
+        const double naiveNanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = NaivePercentEncode(decoded).length();
+            }
+        );
+        printf(
+            "%14zu %12.2f %12.2f\n",
+            spacing,
+            (double)decoded.length() / nanoseconds,
+            (double)decoded.length() / naiveNanoseconds
+        );
+    }
+}
+
+/**
+ * This benchmark renders parsed URIs of several lengths as strings,
+ * both into a new string and into a buffer, and reports the time
+ * taken, compared with just copying the characters of the result.
+ */
+void BenchmarkGenerateString() {
+    printf("%10s %12s %12s %12s %12s\n", "bytes", "ns/string", "ns/buffer", "ns/copy", "ns/copy+new");
+    const std::string uriStrings[] = {
+        "http://www.example.com/",
+        "https://joe@www.example.com:8080/docs/guide/index.html?lang=en#install",
+        "/search?q=" + std::string(1000, 'q'),
+        "http://example.com/" + std::string(65536, 'p'),
+    };
+    for (const auto& uriString: uriStrings) {
+        Uri::Uri uri;
+        (void)uri.ParseFromString(uriString);
+        std::vector< char > output(uriString.length());
+        const double stringNanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = uri.GenerateString().length();
+            }
+        );
+        const double bufferNanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = uri.GenerateString(output.data(), output.size());
+            }
+        );
+        const double copyNanoseconds = MeasureNanoseconds(
+            [&]{
+                memcpy(output.data(), uriString.data(), uriString.length());
+                sink = (size_t)output[0];
+            }
+        );
+        const double copyNewNanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = std::string(uriString).length();
+            }
+        );
+        printf(
+            "%10zu %12.1f %12.1f %12.1f %12.1f\n",
+            uriString.length(),
+            stringNanoseconds,
+            bufferNanoseconds,
+            copyNanoseconds,
+            copyNewNanoseconds
+        );
+    }
+}
+
+/**
+ * This benchmark resolves references of several kinds against a
+ * parsed base URI, and reports the time taken per resolution.
+ */
+void BenchmarkResolve() {
+    printf("%28s %12s\n", "reference", "ns/resolve");
+    Uri::Uri base;
+    (void)base.ParseFromString("https://www.example.com/docs/2024/guide/index.html?lang=en");
+    const char* const references[] = {
+        "",
+        "#install",
+        "setup.html",
+        "../../img/logo.png?v=3",
+        "/login?next=%2Fdocs",
+        "//cdn.example.net/app.js",
+        "https://other.example.org/",
+    };
+    for (const auto referenceString: references) {
+        Uri::Uri reference;
+        (void)reference.ParseFromString(referenceString);
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                sink = Uri::Resolve(base, reference).GetHost().size();
+            }
+        );
+        printf("%28s %12.1f\n", referenceString, nanoseconds);
+    }
+}
+
+/**
+ * This benchmark resolves the links of a crawled page, a thousand
+ * references mostly relative to the page, against the page, and
+ * reports the time taken per link, in bulk against the prepared base,
+ * compared with resolving each link on its own with Uri::Resolve.
+ */
+void BenchmarkResolveBatch() {
+    const std::string baseString = "https://www.example.com/docs/2024/guide/index.html?lang=en";
+    const char* const links[] = {
+        "setup.html",
+        "install/linux.html#requirements",
+        "../api/reference.html",
+        "/about",
+        "#top",
+        "images/diagram-1.png",
+        "https://cdn.example.net/app.js",
+        "faq.html?section=3",
+    };
+    const size_t count = 1000;
+    std::string buffer;
+    std::vector< size_t > offsets(1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        buffer += links[i % (sizeof(links) / sizeof(links[0]))];
+        offsets.push_back(buffer.length());
+    }
+    Uri::BaseResolver resolver;
+    (void)resolver.SetBase(baseString);
+    Uri::ResolvedBatch results;
+    const double batchNanoseconds = MeasureNanoseconds(
+        [&]{
+            sink = resolver.ResolveBatch(buffer.data(), offsets.data(), count, results);
+        }
+    );
+    Uri::Uri base;
+    (void)base.ParseFromString(baseString);
+    const double separateNanoseconds = MeasureNanoseconds(
+        [&]{
+            for (size_t i = 0; i < count; ++i) {
+                Uri::Uri reference;
+                (void)reference.ParseFromString(buffer.substr(offsets[i], offsets[i + 1] - offsets[i]));
+                sink = Uri::Resolve(base, reference).GenerateString().length();
+            }
+        }
+    );
+    const double independentNanoseconds = MeasureNanoseconds(
+        [&]{
+            for (size_t i = 0; i < count; ++i) {
+                Uri::Uri pageBase;
+                (void)pageBase.ParseFromString(baseString);
+                Uri::Uri reference;
+                (void)reference.ParseFromString(buffer.substr(offsets[i], offsets[i + 1] - offsets[i]));
+                sink = Uri::Resolve(pageBase, reference).GenerateString().length();
+            }
+        }
+    );
+    printf("%28s %12s\n", "method", "ns/link");
+    printf("%28s %12.1f\n", "BaseResolver::ResolveBatch", batchNanoseconds / count);
+    printf("%28s %12.1f\n", "Uri::Resolve, parsed base", separateNanoseconds / count);
+    printf("%28s %12.1f\n", "Uri::Resolve, independent", independentNanoseconds / count);
+}
+
+/**
+ * This benchmark normalizes parsed URIs which need more and less
+ * changing, and reports the time taken per URI, compared with just
+ * parsing the URI into a copy, the least a normalizer which renders
+ * the URI and parses it again would have to do on top.
+ */
+void BenchmarkNormalize() {
+    printf("%44s %14s %14s\n", "URI", "ns/normalize", "ns/reparse");
+    const char* const uriStrings[] = {
+        "http://example.com/a/b/~",
+        "HTTP://Example.COM:80/a/./b/%7e",
+        "https://www.example.com/docs/2024/../2025/guide/index.html?lang=en&q=%7euser",
+    };
+    for (const auto uriString: uriStrings) {
+        Uri::Uri original;
+        (void)original.ParseFromString(uriString);
+        const double normalizeNanoseconds = MeasureNanoseconds(
+            [&]{
+                Uri::Uri uri(original);
+                uri.Normalize();
+                sink = uri.GetHost().size();
+            }
+        );
+        const std::string rendered = original.GenerateString();
+        const double reparseNanoseconds = MeasureNanoseconds(
+            [&]{
+                Uri::Uri uri(original);
+                (void)uri.ParseFromString(rendered);
+                sink = uri.GetHost().size();
+            }
+        );
+        printf("%44.44s %14.1f %14.1f\n", uriString, normalizeNanoseconds, reparseNanoseconds);
+    }
+}
+
+/**
+ * This benchmark computes cache keys of a batch of URIs like those
+ * found in access logs, straight from their characters, and reports
+ * the time taken per URI, compared with parsing each into a Uri,
+ * normalizing it, rendering it, and hashing the string.
+ */
+void BenchmarkFingerprint() {
+    const size_t count = 10000;
+    std::string buffer;
+    std::vector< size_t > offsets;
+    MakeLogBatch(count, buffer, offsets);
+    Uri::FingerprintOptions options;
+    options.excludeTrackingParameters = true;
+    const double fingerprintNanoseconds = MeasureNanoseconds(
+        [&]{
+            for (size_t i = 0; i < count; ++i) {
+                Uri::Fingerprint128 fingerprint;
+                (void)Uri::Fingerprint(buffer.data() + offsets[i], offsets[i + 1] - offsets[i], options, fingerprint);
+                sink = (size_t)fingerprint.low;
+            }
+        }
+    );
+    const double fingerprint64Nanoseconds = MeasureNanoseconds(
+        [&]{
+            for (size_t i = 0; i < count; ++i) {
+                uint64_t fingerprint;
+                (void)Uri::Fingerprint(buffer.data() + offsets[i], offsets[i + 1] - offsets[i], options, fingerprint);
+                sink = (size_t)fingerprint;
+            }
+        }
+    );
+    const double renderNanoseconds = MeasureNanoseconds(
+        [&]{
+            for (size_t i = 0; i < count; ++i) {
+                Uri::Uri uri;
+                (void)uri.ParseFromString(buffer.substr(offsets[i], offsets[i + 1] - offsets[i]));
+                uri.Normalize();
+                sink = std::hash< std::string >()(uri.GenerateString());
+            }
+        }
+    );
+    printf("%32s %10s\n", "method", "ns/URI");
+    printf("%32s %10.1f\n", "Fingerprint, 128-bit", fingerprintNanoseconds / count);
+    printf("%32s %10.1f\n", "Fingerprint, 64-bit", fingerprint64Nanoseconds / count);
+    printf("%32s %10.1f\n", "parse, normalize, render, hash", renderNanoseconds / count);
+}
+
+/**
+ * This benchmark compares pairs of URIs, equal, differing at the end,
+ * and equivalent but written differently, and reports the time taken
+ * per comparison, compared with copying each element out through the
+ * getters and comparing the copies.
+ */
+void BenchmarkCompare() {
+    printf("%10s %10s %12s %14s\n", "pair", "ns/==", "ns/Equiv", "ns/getters");
+    const char* const pairs[][3] = {
+        {"equal", "https://www.example.com/docs/2024/guide/index.html?lang=en#install", "https://www.example.com/docs/2024/guide/index.html?lang=en#install"},
+        {"differ", "https://www.example.com/docs/2024/guide/index.html?lang=en#install", "https://www.example.com/docs/2024/guide/index.html?lang=de#install"},
+        {"equiv", "HTTPS://www.Example.com:443/docs/2024/guide/%7Eindex.html?lang=en#install", "https://www.example.com/docs/2024/guide/~index.html?lang=en#install"},
+    };
+    for (const auto& pair: pairs) {
+        Uri::Uri uri, other;
+        (void)uri.ParseFromString(pair[1]);
+        (void)other.ParseFromString(pair[2]);
+        const double equalNanoseconds = MeasureNanoseconds(
+            [&]{
+                for (int i = 0; i < 100; ++i) {
+                    sink = (uri == other);
+                }
+            }
+        );
+        const double equivalentNanoseconds = MeasureNanoseconds(
+            [&]{
+                for (int i = 0; i < 100; ++i) {
+                    sink = uri.EquivalentTo(other);
+                }
+            }
+        );
+        const double gettersNanoseconds = MeasureNanoseconds(
+            [&]{
+                for (int i = 0; i < 100; ++i) {
+                    sink = (
+                        (std::string(uri.GetScheme()) == std::string(other.GetScheme()))
+                        && (std::string(uri.GetUserInfo()) == std::string(other.GetUserInfo()))
+                        && (std::string(uri.GetHost()) == std::string(other.GetHost()))
+                        && (uri.HasPort() == other.HasPort())
+                        && (uri.GetPort() == other.GetPort())
+                        && (std::vector< std::string >(uri.GetPath()) == std::vector< std::string >(other.GetPath()))
+                        && (std::string(uri.GetQuery()) == std::string(other.GetQuery()))
+                        && (std::string(uri.GetFragment()) == std::string(other.GetFragment()))
+                    );
+                }
+            }
+        );
+        printf(
+            "%10s %10.1f %12.1f %14.1f\n",
+            pair[0],
+            equalNanoseconds / 100,
+            equivalentNanoseconds / 100,
+            gettersNanoseconds / 100
+        );
+    }
+}
+
+/**
+ * This function splits a query into its keys and values by copying
+ * each out, the way code without a query facility typically does,
+ * to compare with.
+ */
+size_t NaiveSplitQuery(const std::string& query) {
+    std::vector< std::pair< std::string, std::string > > parameters;
+    size_t begin = 0;
+    while (begin < query.length()) {
+        auto end = query.find('&', begin);
+        if (end == std::string::npos) {
+            end = query.length();
+        }
+        const auto parameter = query.substr(begin, end - begin);
+        const auto equals = parameter.find('=');
+        if (equals == std::string::npos) {
+            parameters.emplace_back(parameter, "");
+        } else {
+            parameters.emplace_back(parameter.substr(0, equals), parameter.substr(equals + 1));
+        }
+        begin = end + 1;
+    }
+    return parameters.size();
+}
+
+/**
+ * This benchmark splits a query like those sent to ad endpoints, with
+ * 60 parameters in about 2 KB, into its keys and values, with each
+ * kernel set, and with decoding the values, and reports the time taken
+ * per query, compared with copying each key and value out.
+ */
+void BenchmarkQueryParameters() {
+    std::string query;
+    for (size_t i = 0; query.length() < 2000; ++i) {
+        if (!query.empty()) {
+            query += '&';
+        }
+        switch (i % 4) {
+            case 0: query += "id" + std::to_string(i) + "=" + std::to_string(i * 7919); break;
+            case 1: query += "ref=https%3A%2F%2Fwww.example.com%2Fpage%2F" + std::to_string(i); break;
+            case 2: query += "utm_campaign=spring+sale+" + std::to_string(i); break;
+            default: query += "sz=300x250&ord=" + std::to_string(i * 104729); break;
+        }
+    }
+    size_t count = 0;
+    for (const auto& parameter: Uri::QueryParameters(Uri::StringView(query))) {
+        (void)parameter;
+        ++count;
+    }
+    printf("query: %zu bytes, %zu parameters\n", query.length(), count);
+    printf("%32s %12s\n", "method", "ns/query");
+    const auto original = Uri::GetKernelSet();
+    for (const auto kernelSet: {Uri::KernelSet::Scalar, Uri::KernelSet::Sse2, Uri::KernelSet::Avx2, Uri::KernelSet::Avx512}) {
+        if (!Uri::SelectKernelSet(kernelSet)) {
+            continue;
+        }
+        const double nanoseconds = MeasureNanoseconds(
+            [&]{
+                size_t total = 0;
+                for (const auto& parameter: Uri::QueryParameters(Uri::StringView(query))) {
+                    total += parameter.key.size() + parameter.value.size();
+                }
+                sink = total;
+            }
+        );
+        printf("%25s, %5s %12.1f\n", "QueryParameters", Uri::GetKernelSetName(kernelSet), nanoseconds);
+    }
+    (void)Uri::SelectKernelSet(original);
+    const double decodeNanoseconds = MeasureNanoseconds(
+        [&]{
+            size_t total = 0;
+            std::string scratch;
+            for (const auto& parameter: Uri::QueryParameters(Uri::StringView(query))) {
+                Uri::StringView value;
+                (void)parameter.DecodeValue(scratch, value);
+                total += parameter.key.size() + value.size();
+            }
+            sink = total;
+        }
+    );
+    printf("%32s %12.1f\n", "QueryParameters, decoding values", decodeNanoseconds);
+    const double naiveNanoseconds = MeasureNanoseconds(
+        [&]{
+            sink = NaiveSplitQuery(query);
+        }
+    );
+    printf("%32s %12.1f\n", "copying keys and values", naiveNanoseconds);
+}
+
+/**
+ * This function finds the value of the first parameter of the given
+ * URI with the given key by searching its query from the beginning,
+ * to compare with.
+ */
+Uri::StringView SearchQuery(const Uri::Uri& uri, const Uri::StringView& key) {
+    for (const auto& parameter: uri.GetQueryParameters()) {
+        if (parameter.key == key) {
+            return parameter.value;
+        }
+    }
+    return Uri::StringView();
+}
+
+/**
+ * This benchmark looks up four parameters, one of them missing, in
+ * a fresh copy of a URI, as a request handler does, with queries of
+ * more and more parameters, and reports the time taken per request,
+ * compared with searching the query from the beginning every time.
+ * Where the two cross over is where it's worth building an index.
+ */
+void BenchmarkQueryLookup() {
+    printf("%12s %12s %14s %14s\n", "parameters", "characters", "ns/lookups", "ns/searches");
+    for (size_t count = 1; count <= 128; count *= 2) {
+        std::string uriString = "http://ads.example.com/serve?";
+        for (size_t i = 0; i < count; ++i) {
+            uriString += (i == 0 ? "" : "&") + std::string("key") + std::to_string(i) + "=value" + std::to_string(i * 31);
+        }
+        Uri::Uri original;
+        (void)original.ParseFromString(uriString);
+        const std::string keyStrings[] = {
+            "key0",
+            "key" + std::to_string(count / 2),
+            "key" + std::to_string(count - 1),
+            "missing",
+        };
+        const Uri::StringView keys[] = {keyStrings[0], keyStrings[1], keyStrings[2], keyStrings[3]};
+        const double lookupNanoseconds = MeasureNanoseconds(
+            [&]{
+                Uri::Uri uri(original);
+                size_t total = 0;
+                for (const auto& key: keys) {
+                    total += uri.GetQueryParameter(key).size();
+                }
+                sink = total;
+            }
+        );
+        const double searchNanoseconds = MeasureNanoseconds(
+            [&]{
+                Uri::Uri uri(original);
+                size_t total = 0;
+                for (const auto& key: keys) {
+                    total += SearchQuery(uri, key).size();
+                }
+                sink = total;
+            }
+        );
+        printf(
+            "%12zu %12zu %14.1f %14.1f\n",
+            count,
+            original.GetQuery().size(),
+            lookupNanoseconds,
+            searchNanoseconds
+        );
+    }
+}
+
+/**
+ * These are the keys which the QueryKeySet benchmark picks
+ * out of every query.
+ */
+struct CampaignKeys {
+    static constexpr const char* keys[] = {
+        "utm_source", "utm_medium", "utm_campaign", "utm_term", "utm_content",
+        "utm_id", "gclid", "fbclid", "msclkid", "sid", "session_id", "ref",
+    };
+};
+
+// The comparisons read the keys at run time, so they
+// need to be defined outside of the class too.
+constexpr const char* CampaignKeys::keys[];
+
+/**
+ * This benchmark picks a dozen campaign keys out of queries like
+ * those of landing pages, most of whose keys aren't in the set, and
+ * reports the time taken per query, compared with comparing each key
+ * of the query with each key of the set.
+ */
+void BenchmarkQueryKeySet() {
+    using KeySet = Uri::QueryKeySet< CampaignKeys >;
+    const std::string queries[] = {
+        "utm_source=google&utm_medium=cpc&utm_campaign=spring_sale&gclid=EAIaIQobChMI",
+        "id=12345&color=red&size=m&ref=homepage&sort=price&page=2&view=grid&lang=en",
+        (
+            "q=running+shoes&category=sports&brand=acme&min_price=20&max_price=150"
+            "&utm_source=newsletter&utm_medium=email&utm_campaign=weekly&utm_content=hero"
+            "&sid=a81f9c&currency=USD&country=US&page=1&per_page=48&sort=relevance"
+        ),
+    };
+    printf("%12s %14s %14s\n", "characters", "ns/key set", "ns/comparing");
+    for (const auto& query: queries) {
+        const double keySetNanoseconds = MeasureNanoseconds(
+            [&]{
+                const auto values = KeySet::Extract(query);
+                sink = values.found + values[0].size();
+            }
+        );
+        const double compareNanoseconds = MeasureNanoseconds(
+            [&]{
+                Uri::StringView values[KeySet::NUM_KEYS];
+                uint64_t found = 0;
+                for (const auto& parameter: Uri::QueryParameters(Uri::StringView(query))) {
+                    for (size_t i = 0; i < KeySet::NUM_KEYS; ++i) {
+                        if (((found >> i) & 1) == 0 && (parameter.key == CampaignKeys::keys[i])) {
+                            values[i] = parameter.value;
+                            found |= (uint64_t)1 << i;
+                            break;
+                        }
+                    }
+                }
+                sink = found + values[0].size();
+            }
+        );
+        printf("%12zu %14.1f %14.1f\n", query.length(), keySetNanoseconds, compareNanoseconds);
+    }
+}
+
+/**
+ * This describes one benchmark which the program can run.
+ */
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+/**
+ * These are all the benchmarks which the program can run.
+ */
+const Benchmark benchmarks[] = {
+    {"PathSegments", BenchmarkPathSegments},
+    {"LongQuery", BenchmarkLongQuery},
+    {"ConstructAndParse", BenchmarkConstructAndParse},
+    {"Batch", BenchmarkBatch},
+    {"ParallelBatch", BenchmarkParallelBatch},
+    {"Validate", BenchmarkValidate},
+    {"PercentDecode", BenchmarkPercentDecode},
+    {"PercentEncode", BenchmarkPercentEncode},
+    {"GenerateString", BenchmarkGenerateString},
+    {"Resolve", BenchmarkResolve},
+    {"ResolveBatch", BenchmarkResolveBatch},
+    {"Normalize", BenchmarkNormalize},
+    {"Fingerprint", BenchmarkFingerprint},
+    {"Compare", BenchmarkCompare},
+    {"QueryParameters", BenchmarkQueryParameters},
+    {"QueryLookup", BenchmarkQueryLookup},
+    {"QueryKeySet", BenchmarkQueryKeySet},
+};
+}
+
+int main(int argc, char* argv[]) {
+    printf("kernels: %s\n", Uri::GetKernelSetName(Uri::GetKernelSet()));
+    for (const auto& benchmark: benchmarks) {
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], benchmark.name) == 0) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            printf("== %s\n", benchmark.name);
+            benchmark.run();
+        }
+    }
+    return 0;
+}
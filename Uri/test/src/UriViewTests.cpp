@@ -0,0 +1,138 @@
+/**
+ * @file UriViewTests.cpp
+ *
+ * This module contains the unit tests of the Uri::UriView class
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/UriView.hpp>
+
+#include <string>
+#include <vector>
+
+TEST(UriViewTests, ParseFromStringNoScheme)
+{
+  const std::string uriString = "foo/bar";
+  Uri::UriView uri;
+  ASSERT_TRUE(uri.ParseFromString(uriString));
+  ASSERT_FALSE(uri.HasScheme());
+  ASSERT_EQ("", uri.GetScheme());
+  ASSERT_EQ("foo/bar", uri.GetPath());
+}
+
+TEST(UriViewTests, ParseFromStringAllElements)
+{
+  const std::string uriString = "http://joe@www.example.com:8080/foo/bar?earth?day#bar";
+  Uri::UriView uri;
+  ASSERT_TRUE(uri.ParseFromString(uriString));
+  ASSERT_EQ("http", uri.GetScheme());
+  ASSERT_TRUE(uri.HasAuthority());
+  ASSERT_EQ("joe", uri.GetUserInfo());
+  ASSERT_EQ("www.example.com", uri.GetHost());
+  ASSERT_TRUE(uri.HasPort());
+  ASSERT_EQ(8080, uri.GetPort());
+  ASSERT_EQ("/foo/bar", uri.GetPath());
+  ASSERT_TRUE(uri.HasQuery());
+  ASSERT_EQ("earth?day", uri.GetQuery());
+  ASSERT_TRUE(uri.HasFragment());
+  ASSERT_EQ("bar", uri.GetFragment());
+}
+
+TEST(UriViewTests, ViewsPointIntoParsedCharacters)
+{
+  const std::string uriString = "http://www.example.com/foo?bar#spam";
+  Uri::UriView uri;
+  ASSERT_TRUE(uri.ParseFromString(uriString));
+  ASSERT_EQ(uriString.data() + 7, uri.GetHost().data());
+  ASSERT_EQ(uriString.data() + 22, uri.GetPath().data());
+  ASSERT_EQ(uriString.data() + 27, uri.GetQuery().data());
+  ASSERT_EQ(uriString.data() + 31, uri.GetFragment().data());
+  ASSERT_EQ(22u, uri.GetPathRange().begin);
+  ASSERT_EQ(26u, uri.GetPathRange().end);
+}
+
+TEST(UriViewTests, ParseFromStringWithoutTerminator)
+{
+  const char characters[] = {'h', 't', 't', 'p', ':', '/', '/', 'a', '/', 'b', 'X'};
+  Uri::UriView uri;
+  ASSERT_TRUE(uri.ParseFromString(characters, sizeof(characters) - 1));
+  ASSERT_EQ("a", uri.GetHost());
+  ASSERT_EQ("/b", uri.GetPath());
+}
+
+TEST(UriViewTests, ParseFromStringBadPortNumber)
+{
+  std::vector< std::string > testVector {
+    "http://www.example.com:spam/foo/bar",
+    "http://www.example.com:65536/foo/bar",
+    "http://www.example.com:-8080/foo/bar",
+  };
+  Uri::UriView uri;
+  for (const auto &uriString : testVector) {
+    ASSERT_FALSE(uri.ParseFromString(uriString)) << uriString;
+  }
+}
+
+TEST(UriViewTests, ParseFromStringQueryAndFragmentPresence)
+{
+  struct TestVector {
+    std::string uriString;
+    bool hasQuery;
+    bool hasFragment;
+  };
+  std::vector< TestVector > testVector {
+    {"http://www.example.com/", false, false},
+    {"http://www.example.com?", true, false},
+    {"http://www.example.com#", false, true},
+    {"http://www.example.com?#", true, true},
+  };
+  Uri::UriView uri;
+  for (const auto &test : testVector) {
+    ASSERT_TRUE(uri.ParseFromString(test.uriString));
+    ASSERT_EQ(test.hasQuery, uri.HasQuery()) << test.uriString;
+    ASSERT_EQ(test.hasFragment, uri.HasFragment()) << test.uriString;
+    ASSERT_TRUE(uri.GetQuery().empty());
+    ASSERT_TRUE(uri.GetFragment().empty());
+  }
+}
+
+TEST(UriViewTests, ParseFromStringTwiceResetsElements)
+{
+  const std::string firstString = "http://joe@www.example.com:80/foo?bar#spam";
+  const std::string secondString = "foo";
+  Uri::UriView uri;
+  ASSERT_TRUE(uri.ParseFromString(firstString));
+  ASSERT_TRUE(uri.ParseFromString(secondString));
+  ASSERT_FALSE(uri.HasAuthority());
+  ASSERT_FALSE(uri.HasPort());
+  ASSERT_FALSE(uri.HasQuery());
+  ASSERT_FALSE(uri.HasFragment());
+  ASSERT_TRUE(uri.GetUserInfo().empty());
+  ASSERT_TRUE(uri.GetHost().empty());
+  ASSERT_TRUE(uri.ContainsRelativePath());
+}
+
+TEST(UriViewTests, DelimitersFoundAnywhereInLongElements)
+{
+  Uri::UriView uri;
+  for (size_t position = 0; position < 200; ++position) {
+    std::string query(300, 'a');
+    query[position] = '#';
+    const std::string uriString = "http://www.example.com/?" + query;
+    ASSERT_TRUE(uri.ParseFromString(uriString)) << position;
+    ASSERT_EQ(query.substr(0, position), uri.GetQuery()) << position;
+    ASSERT_EQ(query.substr(position + 1), uri.GetFragment()) << position;
+
+    std::string path(300, '~');
+    path[position] = '/';
+    path[299] = '^';
+    const std::string badEnding = "http://www.example.com/" + path;
+    ASSERT_FALSE(uri.ParseFromString(badEnding)) << position;
+    path[299] = '=';
+    const std::string goodEnding = "http://www.example.com/" + path;
+    ASSERT_TRUE(uri.ParseFromString(goodEnding)) << position;
+    path[position] = '\x80';
+    const std::string badCharacter = "http://www.example.com/" + path;
+    ASSERT_FALSE(uri.ParseFromString(badCharacter)) << position;
+  }
+}
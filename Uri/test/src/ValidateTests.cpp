@@ -0,0 +1,169 @@
+/**
+ * @file ValidateTests.cpp
+ *
+ * This module contains the unit tests of the functions which check
+ * whether or not characters make up a valid URI.
+ */
+
+#include <gtest/gtest.h>
+#include <Uri/StreamingParser.hpp>
+#include <Uri/UriView.hpp>
+#include <Uri/Validate.hpp>
+
+#include <string>
+#include <vector>
+
+TEST(ValidateTests, ValidUris)
+{
+  const std::vector< std::string > validUris{
+    "",
+    "http://www.example.com/",
+    "https://joe:pw@[::1]:8080/a/b%20c?q=1&r=/?#frag/?",
+    "urn:book:fantasy:Hobbit",
+    "foo/bar:baz",
+    "//example.com:",
+    "?",
+    "#",
+  };
+  for (const auto &uriString : validUris) {
+    const auto result = Uri::Validate(uriString);
+    ASSERT_TRUE(result.IsValid()) << uriString;
+    ASSERT_EQ(Uri::ValidationError::None, result.error) << uriString;
+    ASSERT_EQ(0, result.errorOffset) << uriString;
+    ASSERT_TRUE(Uri::IsValid(uriString)) << uriString;
+  }
+}
+
+TEST(ValidateTests, InvalidUrisWithReasonAndPosition)
+{
+  struct TestVector {
+    std::string uriString;
+    Uri::ValidationError error;
+    size_t errorOffset;
+  };
+  const std::vector< TestVector > testVectors{
+    {"http://exa mple.com/", Uri::ValidationError::IllegalCharacter, 10},
+    {"/caf\xc3\xa9", Uri::ValidationError::IllegalCharacter, 4},
+    {"/a{b}", Uri::ValidationError::IllegalCharacter, 2},
+    {"_:/b", Uri::ValidationError::MisplacedCharacter, 1},
+    {"/a[b]", Uri::ValidationError::MisplacedCharacter, 2},
+    {"//a@b@c", Uri::ValidationError::MisplacedCharacter, 5},
+    {"/a%zz", Uri::ValidationError::BadPercentEncoding, 3},
+    {"/a%4z", Uri::ValidationError::BadPercentEncoding, 4},
+    {"/a%4", Uri::ValidationError::BadPercentEncoding, 4},
+    {"http://example.com:65536/", Uri::ValidationError::BadPort, 24},
+    {"http://example.com:65536", Uri::ValidationError::BadPort, 24},
+    {"http://example.com:8x/", Uri::ValidationError::BadPort, 21},
+    {"http://example.com:8x", Uri::ValidationError::BadPort, 21},
+    {"http://joe@example.com:99999", Uri::ValidationError::BadPort, 27},
+    {"http://joe@example.com:1a", Uri::ValidationError::BadPort, 24},
+    {"http://[::1", Uri::ValidationError::BadIpLiteral, 11},
+    {"http://[::1]x/", Uri::ValidationError::BadIpLiteral, 12},
+    {"http://[::1]8/", Uri::ValidationError::BadIpLiteral, 12},
+    {"http://[::%1]/", Uri::ValidationError::BadIpLiteral, 10},
+    {"http://[]/", Uri::ValidationError::BadIpLiteral, 8},
+    {"http://[http]/", Uri::ValidationError::BadIpLiteral, 8},
+    {"http://[:::::]/", Uri::ValidationError::BadIpLiteral, 10},
+    {"F://[http]", Uri::ValidationError::BadIpLiteral, 5},
+  };
+  for (const auto &testVector : testVectors) {
+    const auto result = Uri::Validate(testVector.uriString);
+    ASSERT_FALSE(result.IsValid()) << testVector.uriString;
+    ASSERT_EQ(testVector.error, result.error) << testVector.uriString;
+    ASSERT_EQ(testVector.errorOffset, result.errorOffset) << testVector.uriString;
+    ASSERT_FALSE(Uri::IsValid(testVector.uriString)) << testVector.uriString;
+    Uri::UriView view;
+    ASSERT_FALSE(view.ParseFromString(testVector.uriString)) << testVector.uriString;
+  }
+}
+
+TEST(ValidateTests, IpLiterals)
+{
+  const std::vector< std::string > validHosts{
+    "[::]",
+    "[::1]",
+    "[1:2:3:4:5:6:7:8]",
+    "[1:2:3:4:5:6:7::]",
+    "[::2:3:4:5:6:7:8]",
+    "[2001:DB8::a:0]",
+    "[fe80::1:2]",
+    "[1:2:3:4:5:6:1.2.3.4]",
+    "[::ffff:192.0.2.255]",
+    "[::0.0.0.0]",
+    "[v7.fe80::a+en1]",
+    "[VF.x]",
+    "[v1a.:]",
+  };
+  for (const auto &host : validHosts) {
+    const std::string uriString = "http://" + host + ":80/";
+    ASSERT_TRUE(Uri::IsValid(uriString)) << uriString;
+
+    // The same is found however the URI is split into pieces.
+    Uri::StreamingParser parser;
+    for (const auto c : uriString) {
+      ASSERT_TRUE(parser.Feed(&c, 1)) << uriString;
+    }
+    ASSERT_TRUE(parser.Finish()) << uriString;
+  }
+
+  const std::vector< std::string > invalidHosts{
+    "[]",
+    "[:]",
+    "[:1]",
+    "[1:]",
+    "[:::]",
+    "[1::2::3]",
+    "[12345::]",
+    "[1:2:3:4:5:6:7]",
+    "[1:2:3:4:5:6:7:8:9]",
+    "[1:2:3:4:5:6:7:8::]",
+    "[::1:2:3:4:5:6:7:8]",
+    "[g::]",
+    "[::1.2.3]",
+    "[::1.2.3.4.5]",
+    "[::1.2.3.256]",
+    "[::01.2.3.4]",
+    "[::1.2.3.4:5]",
+    "[::1.2..3]",
+    "[1:2:3:4:5:6:7:1.2.3.4]",
+    "[1.2.3.4]",
+    "[::a.2.3.4]",
+    "[v]",
+    "[v1]",
+    "[v1.]",
+    "[v.x]",
+    "[vg.x]",
+    "[example.com]",
+  };
+  for (const auto &host : invalidHosts) {
+    const std::string uriString = "http://" + host + "/";
+    const auto result = Uri::Validate(uriString);
+    ASSERT_FALSE(result.IsValid()) << uriString;
+    ASSERT_EQ(Uri::ValidationError::BadIpLiteral, result.error) << uriString;
+
+    Uri::StreamingParser parser;
+    bool valid = true;
+    for (const auto c : uriString) {
+      valid = valid && parser.Feed(&c, 1);
+    }
+    ASSERT_FALSE(valid && parser.Finish()) << uriString;
+  }
+}
+
+TEST(ValidateTests, ValidationErrorNames)
+{
+  ASSERT_STREQ("none", Uri::GetValidationErrorName(Uri::ValidationError::None));
+  ASSERT_STREQ("bad port", Uri::GetValidationErrorName(Uri::ValidationError::BadPort));
+  ASSERT_STREQ("bad IP literal", Uri::GetValidationErrorName(Uri::ValidationError::BadIpLiteral));
+}
+
+TEST(ValidateTests, LongUriErrorFoundAnywhere)
+{
+  const std::string prefix = "http://example.com/";
+  for (size_t length = 0; length < 300; length += 7) {
+    std::string uriString = prefix + std::string(length, 'a') + "^" + std::string(100, 'b');
+    const auto result = Uri::Validate(uriString);
+    ASSERT_EQ(Uri::ValidationError::IllegalCharacter, result.error) << length;
+    ASSERT_EQ(prefix.length() + length, result.errorOffset) << length;
+  }
+}